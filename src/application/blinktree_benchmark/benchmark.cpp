@@ -69,6 +69,10 @@ void Benchmark::start()
     if (this->_profile)
     {
         mx::tasking::runtime::profile(this->profile_file_name());
+        if constexpr (mx::tasking::config::task_tracing())
+        {
+            mx::tasking::runtime::trace(this->profile_file_name("trace"));
+        }
     }
     this->_chronometer.start(static_cast<std::uint16_t>(static_cast<benchmark::phase>(this->_workload)),
                              this->_current_iteration + 1, this->_cores.current());
@@ -191,9 +195,9 @@ void Benchmark::requests_finished()
     }
 }
 
-std::string Benchmark::profile_file_name() const
+std::string Benchmark::profile_file_name(const std::string &prefix) const
 {
-    return "profiling-" + std::to_string(this->_cores.current().size()) + "-cores" + "-phase-" +
+    return prefix + "-" + std::to_string(this->_cores.current().size()) + "-cores" + "-phase-" +
            std::to_string(static_cast<std::uint16_t>(static_cast<benchmark::phase>(this->_workload))) + "-iteration-" +
            std::to_string(this->_current_iteration) + ".json";
 }
\ No newline at end of file
@@ -83,7 +83,7 @@ private:
     // Name of the file to serialize the tree to.
     const std::string _tree_file_name;
 
-    // If true, use idle profiling.
+    // If true, use idle profiling (and tracing, if enabled by config::task_tracing()).
     const bool _profile;
 
     // Number of open request tasks; used for tracking the benchmark.
@@ -96,8 +96,9 @@ private:
     alignas(64) benchmark::Chronometer<std::uint16_t> _chronometer;
 
     /**
+     * @param prefix Prefix of the file name.
      * @return Name of the file to write profiling results to.
      */
-    [[nodiscard]] std::string profile_file_name() const;
+    [[nodiscard]] std::string profile_file_name(const std::string &prefix = "profiling") const;
 };
 } // namespace application::blinktree_benchmark
\ No newline at end of file
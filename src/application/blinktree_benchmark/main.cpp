@@ -3,6 +3,7 @@
 #include <benchmark/cores.h>
 #include <mx/system/environment.h>
 #include <mx/system/thread.h>
+#include <mx/tasking/prefetch_distance.h>
 #include <mx/tasking/runtime.h>
 #include <mx/util/core_set.h>
 #include <tuple>
@@ -16,7 +17,7 @@ using namespace application::blinktree_benchmark;
  *
  * @return Instance of the benchmark and parameters for tasking runtime.
  */
-std::tuple<Benchmark *, std::uint16_t, bool> create_benchmark(int count_arguments, char **arguments);
+std::tuple<Benchmark *, mx::tasking::PrefetchDistance, bool> create_benchmark(int count_arguments, char **arguments);
 
 /**
  * Starts the benchmark.
@@ -52,7 +53,7 @@ int main(int count_arguments, char **arguments)
     return 0;
 }
 
-std::tuple<Benchmark *, std::uint16_t, bool> create_benchmark(int count_arguments, char **arguments)
+std::tuple<Benchmark *, mx::tasking::PrefetchDistance, bool> create_benchmark(int count_arguments, char **arguments)
 {
     // Set up arguments.
     argparse::ArgumentParser argument_parser("blinktree_benchmark");
@@ -90,10 +91,22 @@ std::tuple<Benchmark *, std::uint16_t, bool> create_benchmark(int count_argument
         .help("Prefer latch for synchronization?")
         .implicit_value(true)
         .default_value(false);
+    argument_parser.add_argument("--mcs")
+        .help("Prefer queue-based (MCS) latch for synchronization?")
+        .implicit_value(true)
+        .default_value(false);
+    argument_parser.add_argument("--cohort")
+        .help("Prefer NUMA-aware cohort latch for synchronization?")
+        .implicit_value(true)
+        .default_value(false);
     argument_parser.add_argument("--olfit")
         .help("Prefer OLFIT for synchronization?")
         .implicit_value(true)
         .default_value(false);
+    argument_parser.add_argument("--adaptive")
+        .help("Switch between OLFIT and scheduled writers at runtime?")
+        .implicit_value(true)
+        .default_value(false);
     argument_parser.add_argument("--sync4me")
         .help("Let the tasking layer decide the synchronization primitive.")
         .implicit_value(true)
@@ -112,9 +125,12 @@ std::tuple<Benchmark *, std::uint16_t, bool> create_benchmark(int count_argument
         .default_value(
             std::vector<std::string>{"workloads/fill_randint_workloada", "workloads/mixed_randint_workloada"});
     argument_parser.add_argument("-pd", "--prefetch-distance")
-        .help("Distance of prefetched data objects (0 = disable prefetching).")
-        .default_value(std::uint16_t(0))
-        .action([](const std::string &value) { return std::uint16_t(std::stoi(value)); });
+        .help("Distance of prefetched data objects (0 = disable prefetching, auto = tune at runtime).")
+        .default_value(mx::tasking::PrefetchDistance{0U})
+        .action([](const std::string &value) {
+            return value == "auto" ? mx::tasking::PrefetchDistance::make_automatic()
+                                   : mx::tasking::PrefetchDistance{std::uint16_t(std::stoi(value))};
+        });
     argument_parser.add_argument("--system-allocator")
         .help("Use the systems malloc interface to allocate tasks (default disabled).")
         .implicit_value(true)
@@ -141,7 +157,7 @@ std::tuple<Benchmark *, std::uint16_t, bool> create_benchmark(int count_argument
     catch (std::runtime_error &e)
     {
         std::cout << argument_parser << std::endl;
-        return {nullptr, 0U, false};
+        return {nullptr, mx::tasking::PrefetchDistance{0U}, false};
     }
 
     auto order =
@@ -153,7 +169,15 @@ std::tuple<Benchmark *, std::uint16_t, bool> create_benchmark(int count_argument
                                      ? mx::synchronization::isolation_level::Exclusive
                                      : mx::synchronization::isolation_level::ExclusiveWriter;
     auto preferred_synchronization_method = mx::synchronization::protocol::Queue;
-    if (argument_parser.get<bool>("--latched"))
+    if (argument_parser.get<bool>("--mcs"))
+    {
+        preferred_synchronization_method = mx::synchronization::protocol::MCSLatch;
+    }
+    else if (argument_parser.get<bool>("--cohort"))
+    {
+        preferred_synchronization_method = mx::synchronization::protocol::CohortLatch;
+    }
+    else if (argument_parser.get<bool>("--latched"))
     {
         preferred_synchronization_method = mx::synchronization::protocol::Latch;
     }
@@ -161,6 +185,10 @@ std::tuple<Benchmark *, std::uint16_t, bool> create_benchmark(int count_argument
     {
         preferred_synchronization_method = mx::synchronization::protocol::OLFIT;
     }
+    else if (argument_parser.get<bool>("--adaptive"))
+    {
+        preferred_synchronization_method = mx::synchronization::protocol::Adaptive;
+    }
     else if (argument_parser.get<bool>("--sync4me"))
     {
         preferred_synchronization_method = mx::synchronization::protocol::None;
@@ -175,5 +203,6 @@ std::tuple<Benchmark *, std::uint16_t, bool> create_benchmark(int count_argument
                       argument_parser.get<std::string>("-os"), argument_parser.get<std::string>("-ot"),
                       argument_parser.get<bool>("--profiling"));
 
-    return {benchmark, argument_parser.get<std::uint16_t>("-pd"), argument_parser.get<bool>("--system-allocator")};
+    return {benchmark, argument_parser.get<mx::tasking::PrefetchDistance>("-pd"),
+            argument_parser.get<bool>("--system-allocator")};
 }
\ No newline at end of file
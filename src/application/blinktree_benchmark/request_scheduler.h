@@ -227,7 +227,7 @@ public:
                     task->is_readonly(_tree->height() > 1U);
                 }
 
-                task->annotate(_tree->root(), db::index::blinktree::config::node_size() / 4U);
+                task->annotate(_tree->root(), mx::tasking::PrefetchDescriptor::make_callback());
                 mx::tasking::runtime::spawn(*task, channel_id);
             }
         }
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <limits>
 #include <mx/memory/alignment_helper.h>
+#include <mx/system/cache.h>
 #include <utility>
 
 namespace application::hash_join {
@@ -77,6 +78,12 @@ public:
         }
     }
 
+    /**
+     * @param key Key.
+     * @return The first slot probed when looking up the given key.
+     */
+    [[nodiscard]] std::size_t slot(const K key) const noexcept { return hash(key) & (_slots - 1U); }
+
     const Entry &at(const std::size_t slot) const noexcept { return reinterpret_cast<const Entry *>(this + 1)[slot]; }
 
     Entry &at(const std::size_t slot) noexcept { return reinterpret_cast<Entry *>(this + 1)[slot]; }
@@ -2,12 +2,13 @@
 #include <argparse.hpp>
 #include <iostream>
 #include <mx/system/environment.h>
+#include <mx/tasking/prefetch_distance.h>
 #include <utility>
 #include <vector>
 
 using namespace application::hash_join;
 
-std::pair<Benchmark *, std::uint16_t> create_benchmark(int count_arguments, char **arguments);
+std::pair<Benchmark *, mx::tasking::PrefetchDistance> create_benchmark(int count_arguments, char **arguments);
 
 int main(int count_arguments, char **arguments)
 {
@@ -36,7 +37,7 @@ int main(int count_arguments, char **arguments)
     return 0;
 }
 
-std::pair<Benchmark *, std::uint16_t> create_benchmark(int count_arguments, char **arguments)
+std::pair<Benchmark *, mx::tasking::PrefetchDistance> create_benchmark(int count_arguments, char **arguments)
 {
     argparse::ArgumentParser argument_parser("hashjoin_benchmark");
     argument_parser.add_argument("cores")
@@ -60,9 +61,12 @@ std::pair<Benchmark *, std::uint16_t> create_benchmark(int count_arguments, char
         .implicit_value(true)
         .default_value(false);
     argument_parser.add_argument("-pd", "--prefetch-distance")
-        .help("Distance of prefetched data objects (0 = disable prefetching).")
-        .default_value(std::uint16_t(0U))
-        .action([](const std::string &value) { return std::uint16_t(std::stoi(value)); });
+        .help("Distance of prefetched data objects (0 = disable prefetching, auto = tune at runtime).")
+        .default_value(mx::tasking::PrefetchDistance{0U})
+        .action([](const std::string &value) {
+            return value == "auto" ? mx::tasking::PrefetchDistance::make_automatic()
+                                   : mx::tasking::PrefetchDistance{std::uint16_t(std::stoi(value))};
+        });
     argument_parser.add_argument("-o", "--out")
         .help("Name of the file, the results will be written to.")
         .default_value(std::string(""));
@@ -113,5 +117,5 @@ std::pair<Benchmark *, std::uint16_t> create_benchmark(int count_arguments, char
                                     std::move(build_probe_batches), std::make_tuple(std::move(r), std::move(s)),
                                     argument_parser.get<bool>("-p"), argument_parser.get<std::string>("-o"));
 
-    return {benchmark, argument_parser.get<std::uint16_t>("-pd")};
+    return {benchmark, argument_parser.get<mx::tasking::PrefetchDistance>("-pd")};
 }
\ No newline at end of file
@@ -46,17 +46,18 @@ public:
         {
             if constexpr (std::is_same<T, BuildTask>::value)
             {
-                build_probe_tasks[target_channel_id] = mx::tasking::runtime::new_task<T>(
-                    core_id, _batch_size, mx::tasking::runtime::numa_node_id(target_channel_id));
+                build_probe_tasks[target_channel_id] = mx::tasking::runtime::new_task_for<T>(
+                    core_id, target_channel_id, _batch_size, mx::tasking::runtime::numa_node_id(target_channel_id));
             }
             else
             {
-                build_probe_tasks[target_channel_id] = mx::tasking::runtime::new_task<T>(
-                    core_id, _listener.notificator().result_set(target_channel_id), _batch_size,
+                build_probe_tasks[target_channel_id] = mx::tasking::runtime::new_task_for<T>(
+                    core_id, target_channel_id, _listener.notificator().result_set(target_channel_id), _batch_size,
                     mx::tasking::runtime::numa_node_id(target_channel_id));
             }
 
-            build_probe_tasks[target_channel_id]->annotate(_hash_tables[target_channel_id], 64U);
+            PartitionTask::annotate_hash_table(build_probe_tasks[target_channel_id],
+                                               _hash_tables[target_channel_id]);
         }
 
         auto *data = this->annotated_resource().template get<std::uint32_t>();
@@ -76,17 +77,18 @@ public:
 
                 if constexpr (std::is_same<T, BuildTask>::value)
                 {
-                    build_probe_tasks[target_channel_id] = mx::tasking::runtime::new_task<T>(
-                        core_id, _batch_size, mx::tasking::runtime::numa_node_id(target_channel_id));
+                    build_probe_tasks[target_channel_id] = mx::tasking::runtime::new_task_for<T>(
+                        core_id, target_channel_id, _batch_size, mx::tasking::runtime::numa_node_id(target_channel_id));
                 }
                 else
                 {
-                    build_probe_tasks[target_channel_id] = mx::tasking::runtime::new_task<T>(
-                        core_id, _listener.notificator().result_set(target_channel_id), _batch_size,
+                    build_probe_tasks[target_channel_id] = mx::tasking::runtime::new_task_for<T>(
+                        core_id, target_channel_id, _listener.notificator().result_set(target_channel_id), _batch_size,
                         mx::tasking::runtime::numa_node_id(target_channel_id));
                 }
 
-                build_probe_tasks[target_channel_id]->annotate(_hash_tables[target_channel_id], 64U);
+                PartitionTask::annotate_hash_table(build_probe_tasks[target_channel_id],
+                                                   _hash_tables[target_channel_id]);
             }
         }
 
@@ -113,5 +115,24 @@ private:
     const mx::resource::ptr *_hash_tables;
 
     static std::uint16_t hash(const std::uint32_t key) { return std::hash<std::uint32_t>()(key); }
+
+    /**
+     * Annotates the build/probe task with the hash table. Probe tasks
+     * will prefetch the hash buckets of their keys for reading.
+     * @param task Build or probe task.
+     * @param hash_table Hash table the task will access.
+     */
+    static void annotate_hash_table(T *task, const mx::resource::ptr hash_table) noexcept
+    {
+        if constexpr (std::is_same<T, ProbeTask>::value)
+        {
+            task->annotate(hash_table, mx::tasking::PrefetchDescriptor::make_callback());
+            task->is_readonly(true);
+        }
+        else
+        {
+            task->annotate(hash_table, 64U);
+        }
+    }
 };
 } // namespace application::hash_join
\ No newline at end of file
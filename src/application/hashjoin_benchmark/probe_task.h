@@ -1,6 +1,7 @@
 #pragma once
 
 #include "inline_hashtable.h"
+#include <algorithm>
 #include <iostream>
 #include <mx/tasking/task.h>
 #include <mx/util/vector.h>
@@ -24,28 +25,67 @@ public:
     {
         auto *hashtable = this->annotated_resource().get<InlineHashtable<std::uint32_t, std::size_t>>();
 
-        for (const auto &[row_id, key] : _keys)
+        for (const auto &probe_key : _keys)
         {
-            const auto row = hashtable->get(key);
+            const auto row = hashtable->get(probe_key.key);
             if (row != std::numeric_limits<std::size_t>::max())
             {
-                _result_set.emplace_back(std::make_pair(row_id, row));
+                _result_set.emplace_back(std::make_pair(probe_key.row_id, row));
             }
         }
 
         return mx::tasking::TaskResult::make_remove();
     }
 
+    void prefetch(const mx::system::cache::level level, const mx::system::cache::access access) noexcept override
+    {
+        // Only the address of the buckets is calculated; the hash table is not accessed.
+        auto *hashtable = this->annotated_resource().get<InlineHashtable<std::uint32_t, std::size_t>>();
+
+        const auto count_keys = std::min(_keys.size(), std::size_t(ProbeTask::prefetched_buckets));
+        for (auto i = 0U; i < count_keys; ++i)
+        {
+            mx::system::cache::prefetch(level, access, &hashtable->at(_keys[i].slot));
+        }
+    }
+
+    /**
+     * Adds a key to probe. The hash table has to be annotated before,
+     * since the buckets of the first keys are calculated when adding.
+     * @param row_id Row of the key.
+     * @param key Key to probe.
+     */
     void emplace_back(const std::size_t row_id, const std::uint32_t key) noexcept
     {
-        _keys.emplace_back(std::make_pair(row_id, key));
+        auto slot = std::uint32_t{0U};
+        if (_keys.size() < ProbeTask::prefetched_buckets)
+        {
+            const auto *hashtable = this->annotated_resource().get<InlineHashtable<std::uint32_t, std::size_t>>();
+            slot = std::uint32_t(hashtable->slot(key));
+        }
+
+        _keys.emplace_back(ProbeKey{row_id, key, slot});
     }
 
     [[nodiscard]] std::uint64_t size() const noexcept { return _keys.size(); }
     [[nodiscard]] bool empty() const noexcept { return _keys.empty(); }
 
 private:
-    std::vector<std::pair<std::size_t, std::uint32_t>> _keys;
+    // Number of hash buckets prefetched before the task is executed.
+    static constexpr auto prefetched_buckets = 16U;
+
+    /**
+     * Key to probe and its row. The slot of the first keys is calculated
+     * when the key is added, for prefetching the bucket later.
+     */
+    struct ProbeKey
+    {
+        std::size_t row_id;
+        std::uint32_t key;
+        std::uint32_t slot;
+    };
+
+    std::vector<ProbeKey> _keys;
     mx::util::vector<std::pair<std::size_t, std::size_t>> &_result_set;
 };
 } // namespace application::hash_join
\ No newline at end of file
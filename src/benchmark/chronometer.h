@@ -2,10 +2,16 @@
 
 #include "perf.h"
 #include "phase.h"
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <json.hpp>
+#include <mx/memory/config.h>
+#include <mx/memory/statistic.h>
+#include <mx/system/topology.h>
 #include <mx/tasking/config.h>
 #include <mx/tasking/profiling/statistic.h>
+#include <mx/tasking/profiling/task_latency.h>
 #include <mx/tasking/runtime.h>
 #include <mx/util/core_set.h>
 #include <numeric>
@@ -54,12 +60,14 @@ public:
                   std::unordered_map<std::uint16_t, std::uint64_t> scheduled_tasks,
                   std::unordered_map<std::uint16_t, std::uint64_t> scheduled_tasks_on_core,
                   std::unordered_map<std::uint16_t, std::uint64_t> scheduled_tasks_off_core,
-                  std::unordered_map<std::uint16_t, std::uint64_t> worker_fills)
+                  std::unordered_map<std::uint16_t, std::uint64_t> worker_fills, nlohmann::json memory_statistics,
+                  nlohmann::json task_latencies)
         : _operation_count(operation_count), _phase(phase), _iteration(iteration), _core_count(core_count), _time(time),
           _executed_tasks(std::move(executed_tasks)), _executed_reader_tasks(std::move(executed_reader_tasks)),
           _executed_writer_tasks(std::move(executed_writer_tasks)), _scheduled_tasks(std::move(scheduled_tasks)),
           _scheduled_tasks_on_core(std::move(scheduled_tasks_on_core)),
-          _scheduled_tasks_off_core(std::move(scheduled_tasks_off_core)), _worker_fills(std::move(worker_fills))
+          _scheduled_tasks_off_core(std::move(scheduled_tasks_off_core)), _worker_fills(std::move(worker_fills)),
+          _memory_statistics(std::move(memory_statistics)), _task_latencies(std::move(task_latencies))
     {
         for (auto &c : counter)
         {
@@ -135,6 +143,16 @@ public:
             json["buffer-fills"] = worker_fills() / double(operation_count());
         }
 
+        if constexpr (mx::memory::config::allocator_statistics())
+        {
+            json["memory"] = _memory_statistics;
+        }
+
+        if constexpr (mx::tasking::config::task_latency_histograms())
+        {
+            json["latencies"] = _task_latencies;
+        }
+
         return json;
     }
 
@@ -152,6 +170,8 @@ private:
     const std::unordered_map<std::uint16_t, std::uint64_t> _scheduled_tasks_on_core;
     const std::unordered_map<std::uint16_t, std::uint64_t> _scheduled_tasks_off_core;
     const std::unordered_map<std::uint16_t, std::uint64_t> _worker_fills;
+    const nlohmann::json _memory_statistics;
+    const nlohmann::json _task_latencies;
 
     std::uint64_t sum(const std::unordered_map<std::uint16_t, std::uint64_t> &map) const noexcept
     {
@@ -199,7 +219,9 @@ public:
                 statistic_map(mx::tasking::profiling::Statistic::Scheduled),
                 statistic_map(mx::tasking::profiling::Statistic::ScheduledOnChannel),
                 statistic_map(mx::tasking::profiling::Statistic::ScheduledOffChannel),
-                statistic_map(mx::tasking::profiling::Statistic::Fill)};
+                statistic_map(mx::tasking::profiling::Statistic::Fill),
+                memory_statistics(),
+                task_latencies()};
     }
 
     void add(PerfCounter &performance_counter) { _perf.add(performance_counter); }
@@ -221,5 +243,83 @@ private:
         }
         return statistics;
     }
+
+    /**
+     * @return Counters of the task and resource allocator and the state of their memory per NUMA region.
+     */
+    static nlohmann::json memory_statistics()
+    {
+        if constexpr (mx::memory::config::allocator_statistics() == false)
+        {
+            return nlohmann::json{};
+        }
+
+        constexpr auto counters = std::array<std::pair<mx::memory::Statistic::Counter, const char *>, 6U>{
+            std::make_pair(mx::memory::Statistic::AllocatedObjects, "allocated-objects"),
+            std::make_pair(mx::memory::Statistic::FreedObjects, "freed-objects"),
+            std::make_pair(mx::memory::Statistic::AllocatedBytes, "allocated-bytes"),
+            std::make_pair(mx::memory::Statistic::FreedBytes, "freed-bytes"),
+            std::make_pair(mx::memory::Statistic::RemoteAllocations, "remote-allocations"),
+            std::make_pair(mx::memory::Statistic::RemoteFrees, "remote-frees")};
+
+        const auto node_json = [](const mx::memory::NodeStatistic &statistic) {
+            auto json = nlohmann::json{};
+            json["reserved-bytes"] = statistic.reserved_bytes;
+            json["chunks"] = statistic.count_chunks;
+            json["free-chunks"] = statistic.count_free_chunks;
+            json["free-bytes"] = statistic.free_bytes;
+            json["largest-free-block"] = statistic.largest_free_block;
+            json["free-objects"] = statistic.count_free_objects;
+            return json;
+        };
+
+        auto json = nlohmann::json{};
+        for (const auto &[counter, name] : counters)
+        {
+            json["tasks"][name] = mx::tasking::runtime::task_memory_statistic(counter);
+            json["resources"][name] = mx::tasking::runtime::resource_memory_statistic(counter);
+        }
+
+        const auto count_numa_nodes =
+            std::min<std::uint32_t>(mx::system::topology::max_node_id() + 1U, mx::memory::config::max_numa_nodes());
+        for (auto numa_node_id = 0U; numa_node_id < count_numa_nodes; ++numa_node_id)
+        {
+            json["tasks"]["nodes"].push_back(
+                node_json(mx::tasking::runtime::task_memory_statistic(std::uint8_t(numa_node_id))));
+            json["resources"]["nodes"].push_back(
+                node_json(mx::tasking::runtime::resource_memory_statistic(std::uint8_t(numa_node_id))));
+        }
+
+        return json;
+    }
+
+    /**
+     * @return Number of executed tasks and percentiles (in cycles) of queueing delay and execution time per task type.
+     */
+    static nlohmann::json task_latencies()
+    {
+        if constexpr (mx::tasking::config::task_latency_histograms() == false)
+        {
+            return nlohmann::json{};
+        }
+
+        const auto histogram_json = [](const mx::tasking::profiling::LatencyHistogram &histogram) {
+            auto json = nlohmann::json{};
+            json["p50"] = histogram.percentile(0.5);
+            json["p99"] = histogram.percentile(0.99);
+            json["p999"] = histogram.percentile(0.999);
+            return json;
+        };
+
+        auto json = nlohmann::json{};
+        for (const auto &[task_type, latency] : mx::tasking::runtime::task_latencies())
+        {
+            json[task_type]["count"] = latency.execution_time.count();
+            json[task_type]["queueing-delay"] = histogram_json(latency.queueing_delay);
+            json[task_type]["execution-time"] = histogram_json(latency.execution_time);
+        }
+
+        return json;
+    }
 };
 } // namespace benchmark
\ No newline at end of file
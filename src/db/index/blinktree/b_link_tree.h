@@ -12,6 +12,7 @@
 #include <iostream>
 #include <json.hpp>
 #include <mx/resource/resource.h>
+#include <mx/system/cache.h>
 #include <mx/tasking/runtime.h>
 #include <utility>
 #include <vector>
@@ -67,11 +68,13 @@ public:
      * Creates a node of type leaf.
      *
      * @param parent Parent of the new leaf node.
+     * @param left_sibling Left sibling of the new leaf node; the leaf is preferably placed on its channel.
      * @return Leaf node.
      */
-    [[nodiscard]] mx::resource::ptr create_leaf_node(const mx::resource::ptr parent) const
+    [[nodiscard]] mx::resource::ptr create_leaf_node(const mx::resource::ptr parent,
+                                                     const mx::resource::ptr left_sibling) const
     {
-        return create_node(NodeType::Leaf, parent, false);
+        return create_node(NodeType::Leaf, parent, false, mx::resource::hint::affinity{left_sibling.channel_id()});
     }
 
     /**
@@ -152,16 +155,19 @@ protected:
      * @param node_type Type of the node.
      * @param parent Parent of the node.
      * @param is_root True, if the new node will be the root.
+     * @param affinity Channel the node is preferably placed on.
      * @return Pointer to the new node.
      */
     [[nodiscard]] mx::resource::ptr create_node(const NodeType node_type, const mx::resource::ptr parent,
-                                                const bool is_root) const
+                                                const bool is_root,
+                                                const mx::resource::hint::affinity affinity = {}) const
     {
         const auto is_inner = static_cast<bool>(node_type & NodeType::Inner);
         return mx::tasking::runtime::new_resource<Node<K, V>>(
             config::node_size(),
             mx::resource::hint{_isolation_level, _preferred_synchronization_protocol,
-                               predict_access_frequency(is_inner, is_root), predict_read_write_ratio(is_inner)},
+                               predict_access_frequency(is_inner, is_root), predict_read_write_ratio(is_inner),
+                               predict_prefetch_level(is_inner), affinity},
             node_type, parent);
     }
 
@@ -202,6 +208,19 @@ protected:
                         : mx::resource::hint::expected_read_write_ratio::balanced;
     }
 
+    /**
+     * Create a hint for the cache level nodes are prefetched to.
+     * Inner nodes are passed by many tasks and should stay close
+     * to the core; leaf nodes are mostly touched by a single task.
+     *
+     * @param is_inner True, when the node is an inner node.
+     * @return Cache level for prefetching the node.
+     */
+    [[nodiscard]] static mx::system::cache::level predict_prefetch_level(const bool is_inner)
+    {
+        return is_inner ? mx::system::cache::L1 : mx::system::cache::LLC;
+    }
+
     /**
      * Serializes a tree node to json format.
      *
@@ -317,7 +336,7 @@ std::pair<mx::resource::ptr, K> BLinkTree<K, V>::split(const mx::resource::ptr l
     constexpr std::uint16_t left_size = LeafNode<K, V>::max_items / 2;
     constexpr std::uint16_t right_size = LeafNode<K, V>::max_items - left_size;
 
-    auto new_leaf_node_ptr = this->create_leaf_node(leaf_node->parent());
+    auto new_leaf_node_ptr = this->create_leaf_node(leaf_node->parent(), leaf_node_ptr);
     auto *new_leaf_node = mx::resource::ptr_cast<Node<K, V>>(new_leaf_node_ptr);
 
     leaf_node->move(new_leaf_node_ptr, left_size, right_size);
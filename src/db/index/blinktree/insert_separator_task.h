@@ -33,7 +33,7 @@ mx::tasking::TaskResult InsertSeparatorTask<K, V, L>::execute(const std::uint16_
     // Is the node related to the key?
     if (annotated_node->high_key() <= this->_key)
     {
-        this->annotate(annotated_node->right_sibling(), config::node_size() / 4U);
+        this->annotate(annotated_node->right_sibling(), mx::tasking::PrefetchDescriptor::make_callback());
         return mx::tasking::TaskResult::make_succeed(this);
     }
 
@@ -52,7 +52,7 @@ mx::tasking::TaskResult InsertSeparatorTask<K, V, L>::execute(const std::uint16_
     {
         this->_separator = right;
         this->_key = key;
-        this->annotate(annotated_node->parent(), config::node_size() / 4U);
+        this->annotate(annotated_node->parent(), mx::tasking::PrefetchDescriptor::make_callback());
         return mx::tasking::TaskResult::make_succeed(this);
     }
 
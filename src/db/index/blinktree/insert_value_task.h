@@ -34,7 +34,7 @@ mx::tasking::TaskResult InsertValueTask<K, V, L>::execute(const std::uint16_t co
     // Is the node related to the key?
     if (annotated_node->high_key() <= this->_key)
     {
-        this->annotate(annotated_node->right_sibling(), config::node_size() / 4U);
+        this->annotate(annotated_node->right_sibling(), mx::tasking::PrefetchDescriptor::make_callback());
         return mx::tasking::TaskResult::make_succeed(this);
     }
 
@@ -42,7 +42,7 @@ mx::tasking::TaskResult InsertValueTask<K, V, L>::execute(const std::uint16_t co
     if (annotated_node->is_inner())
     {
         const auto child = annotated_node->child(this->_key);
-        this->annotate(child, config::node_size() / 4U);
+        this->annotate(child, mx::tasking::PrefetchDescriptor::make_callback());
         this->is_readonly(!annotated_node->is_branch());
         return mx::tasking::TaskResult::make_succeed(this);
     }
@@ -74,7 +74,7 @@ mx::tasking::TaskResult InsertValueTask<K, V, L>::execute(const std::uint16_t co
     {
         auto *task = mx::tasking::runtime::new_task<InsertSeparatorTask<K, V, L>>(core_id, key, right, this->_tree,
                                                                                   this->_listener);
-        task->annotate(annotated_node->parent(), config::node_size() / 4U);
+        task->annotate(annotated_node->parent(), mx::tasking::PrefetchDescriptor::make_callback());
         return mx::tasking::TaskResult::make_succeed_and_remove(task);
     }
 
@@ -29,7 +29,7 @@ mx::tasking::TaskResult LookupTask<K, V, L>::execute(const std::uint16_t core_id
     // Is the node related to the key?
     if (annotated_node->high_key() <= this->_key)
     {
-        this->annotate(annotated_node->right_sibling(), config::node_size() / 4U);
+        this->annotate(annotated_node->right_sibling(), mx::tasking::PrefetchDescriptor::make_callback());
         return mx::tasking::TaskResult::make_succeed(this);
     }
 
@@ -37,7 +37,7 @@ mx::tasking::TaskResult LookupTask<K, V, L>::execute(const std::uint16_t core_id
     if (annotated_node->is_inner())
     {
         const auto child = annotated_node->child(this->_key);
-        this->annotate(child, config::node_size() / 4U);
+        this->annotate(child, mx::tasking::PrefetchDescriptor::make_callback());
         return mx::tasking::TaskResult::make_succeed(this);
     }
 
@@ -1,11 +1,13 @@
 #pragma once
 #include "config.h"
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cstdint>
 #include <cstring>
 #include <mx/resource/resource.h>
 #include <mx/resource/resource_interface.h>
+#include <mx/system/cache.h>
 #include <mx/tasking/runtime.h>
 
 namespace db::index::blinktree {
@@ -283,6 +285,18 @@ public:
      */
     [[nodiscard]] bool contains(mx::resource::ptr separator) const noexcept;
 
+    /**
+     * Prefetches the header and the block of keys that will be probed first
+     * by a binary search (assuming the node is filled at least by half).
+     * The node itself will not be accessed.
+     *
+     * @param node Node to prefetch.
+     * @param level Cache level the node is prefetched to.
+     * @param access Access (read or write) the node is prefetched for.
+     */
+    static void prefetch(mx::resource::ptr node, mx::system::cache::level level,
+                         mx::system::cache::access access) noexcept;
+
 private:
     NodeHeader<K, V> _header;
     union {
@@ -319,6 +333,31 @@ template <typename K, typename V> mx::resource::ptr Node<K, V>::child(const K ke
     return this->_inner_node.separators[high + 1U];
 }
 
+template <typename K, typename V>
+void Node<K, V>::prefetch(const mx::resource::ptr node, const mx::system::cache::level level,
+                          const mx::system::cache::access access) noexcept
+{
+    constexpr auto keys_offset = sizeof(mx::resource::ResourceInterface) + sizeof(NodeHeader<K, V>);
+    constexpr auto max_keys = std::min(InnerNode<K, V>::max_keys, LeafNode<K, V>::max_items);
+    constexpr auto predicted_keys_begin = keys_offset + (max_keys / 4U) * sizeof(K);
+    constexpr auto predicted_keys_end = keys_offset + ((max_keys * 3U) / 4U) * sizeof(K);
+    constexpr auto line_size = mx::system::cache::line_size();
+
+    const auto address = std::uintptr_t(node.get());
+
+    // Header.
+    mx::system::cache::prefetch_range(level, access, node.get(), line_size * 2U);
+
+    // Keys probed by the first steps of the binary search.
+    for (auto offset = predicted_keys_begin & ~(line_size - 1U); offset < predicted_keys_end; offset += line_size)
+    {
+        if (offset >= line_size * 2U)
+        {
+            mx::system::cache::prefetch(level, access, reinterpret_cast<void *>(address + offset));
+        }
+    }
+}
+
 template <typename K, typename V>
 void Node<K, V>::insert(const std::uint16_t index, const mx::resource::ptr separator, const K key)
 {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "node.h"
 #include <mx/tasking/task.h>
 
 namespace db::index::blinktree {
@@ -9,6 +10,11 @@ public:
     constexpr Task(const K key, L &listener) : _listener(listener), _key(key) {}
     ~Task() override = default;
 
+    void prefetch(const mx::system::cache::level level, const mx::system::cache::access access) noexcept override
+    {
+        Node<K, V>::prefetch(this->annotated_resource(), level, access);
+    }
+
 protected:
     L &_listener;
     K _key;
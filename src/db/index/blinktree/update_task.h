@@ -30,7 +30,7 @@ mx::tasking::TaskResult UpdateTask<K, V, L>::execute(const std::uint16_t core_id
     // Is the node related to the key?
     if (node->high_key() <= this->_key)
     {
-        this->annotate(node->right_sibling(), config::node_size() / 4U);
+        this->annotate(node->right_sibling(), mx::tasking::PrefetchDescriptor::make_callback());
         return mx::tasking::TaskResult::make_succeed(this);
     }
 
@@ -38,7 +38,7 @@ mx::tasking::TaskResult UpdateTask<K, V, L>::execute(const std::uint16_t core_id
     if (node->is_inner())
     {
         const auto child = node->child(this->_key);
-        this->annotate(child, config::node_size() / 4U);
+        this->annotate(child, mx::tasking::PrefetchDescriptor::make_callback());
         this->is_readonly(!node->is_branch());
         return mx::tasking::TaskResult::make_succeed(this);
     }
@@ -5,19 +5,101 @@ namespace mx::memory {
 class config
 {
 public:
+    enum huge_page_scheme
+    {
+        None = 0U,
+        Transparent = 1U,
+        Explicit = 2U
+    };
+
     /**
      * @return Number of maximal provided NUMA regions.
      */
     static constexpr auto max_numa_nodes() { return 2U; }
 
     /**
-     * @return Interval of each epoch, if memory reclamation is used.
+     * @return Maximal interval of each epoch, if memory reclamation is used.
+     *         While much garbage is collected, the interval is shortened
+     *         (down to min_epoch_interval()); otherwise, it is lengthened.
      */
     static constexpr auto epoch_interval() { return std::chrono::milliseconds(50U); }
+    static constexpr auto min_epoch_interval() { return std::chrono::milliseconds(1U); }
+
+    /**
+     * @return Number of resources removed within an epoch, that halves the epoch interval.
+     */
+    static constexpr auto epoch_garbage_threshold() { return 4096U; }
+
+    /**
+     * @return Number of threads besides the workers (e.g., client threads reading
+     *         optimistic resources directly), that can take part in epochs at the same time.
+     */
+    static constexpr auto max_external_epoch_participants() { return 64U; }
+
+    /**
+     * @return Number of epochs, whose garbage is held by every channel at the same time.
+     *         The global epoch is not entered while the garbage of the oldest epoch
+     *         is still in use by some channel.
+     */
+    static constexpr auto limbo_buckets() { return 4U; }
+
+    /**
+     * @return Number of objects freed by a foreign core, that are
+     *         collected before they are returned to their home core.
+     */
+    static constexpr auto remote_free_batch_size() { return 64U; }
+
+    /**
+     * @return Number of chunks without any object in use, that are cached by
+     *         every core of the task allocator. Further unused chunks are given
+     *         back; their memory is released periodically by the epoch manager.
+     */
+    static constexpr auto max_cached_free_chunks() { return 2U; }
+
+    /**
+     * @return Number of objects of every size class, cached by every
+     *         core of the dynamic allocator.
+     */
+    static constexpr auto size_class_cache_size() { return 32U; }
+
+    /**
+     * @return Size of the address space reserved for every size class
+     *         of the dynamic allocator on every NUMA node.
+     */
+    static constexpr auto size_class_arena_size() { return 1UL << 33U; /* 8gb */ }
+
+    /**
+     * @return Number of resource types that get their own pool of the dynamic
+     *         allocator (sized exactly to the type); further types are served
+     *         by the size classes.
+     */
+    static constexpr auto max_typed_pools() { return 8U; }
+
+    /**
+     * @return True, if the allocators count allocated and freed
+     *         objects and bytes per channel (see memory::Statistic).
+     */
+    static constexpr auto allocator_statistics() { return false; }
+
+    /**
+     * @return Huge pages backing large allocations of the global heap: None (4kb pages),
+     *         Transparent (advises the kernel to use transparent huge pages), or Explicit
+     *         (pages from the hugetlb pool, falling back to transparent huge pages when
+     *         the pool is empty).
+     */
+    static constexpr auto huge_pages() { return huge_page_scheme::None; }
+
+    /**
+     * @return Size of a huge page; 2mb or 1gb (explicit huge pages only).
+     *         Allocations smaller than a huge page use regular pages.
+     */
+    static constexpr auto huge_page_size() { return 1UL << 21U; /* 2mb */ }
 
     /**
-     * @return True, if garbage is removed local.
+     * @return Address the persistent heap is mapped to. Since the heap is
+     *         mapped to the same address on every run, pointers between
+     *         objects on the heap stay valid over restarts.
      */
-    static constexpr auto local_garbage_collection() { return false; }
+    static constexpr auto persistent_heap_address() { return 0x600000000000UL; }
 };
 } // namespace mx::memory
\ No newline at end of file
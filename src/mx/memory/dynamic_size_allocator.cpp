@@ -1,5 +1,6 @@
 #include "dynamic_size_allocator.h"
 #include "global_heap.h"
+#include "persistent_heap.h"
 #include <algorithm>
 #include <cassert>
 #include <mx/system/topology.h>
@@ -13,10 +14,21 @@ AllocationBlock::AllocationBlock(const std::uint32_t id, const std::uint8_t numa
     this->_free_elements.emplace_back(FreeHeader{reinterpret_cast<std::uintptr_t>(this->_allocated_block), size});
 }
 
+AllocationBlock::AllocationBlock(const std::uint32_t id, const std::uint8_t numa_node_id, void *memory,
+                                 const std::size_t size, std::vector<FreeHeader> &&free_elements)
+    : _id(id), _numa_node_id(numa_node_id), _size(size), _allocated_block(memory),
+      _free_elements(std::move(free_elements)), _is_owner(false), _available_size(0U)
+{
+    for (const auto &free_element : this->_free_elements)
+    {
+        this->_available_size += free_element.size();
+    }
+}
+
 AllocationBlock::AllocationBlock(AllocationBlock &&other) noexcept
     : _id(other._id), _numa_node_id(other._numa_node_id), _size(other._size),
       _allocated_block(std::exchange(other._allocated_block, nullptr)), _free_elements(std::move(other._free_elements)),
-      _available_size(other._available_size)
+      _is_owner(other._is_owner), _available_size(other._available_size)
 {
 }
 
@@ -27,13 +39,14 @@ AllocationBlock &AllocationBlock::operator=(AllocationBlock &&other) noexcept
     this->_size = other._size;
     this->_allocated_block = std::exchange(other._allocated_block, nullptr);
     this->_free_elements = std::move(other._free_elements);
+    this->_is_owner = other._is_owner;
     this->_available_size = other._available_size;
     return *this;
 }
 
 AllocationBlock::~AllocationBlock()
 {
-    if (this->_allocated_block != nullptr)
+    if (this->_allocated_block != nullptr && this->_is_owner)
     {
         GlobalHeap::free(this->_allocated_block, this->_size);
     }
@@ -84,6 +97,79 @@ void *AllocationBlock::allocate(const std::size_t alignment, const std::size_t s
     return reinterpret_cast<void *>(allocation_header_address + sizeof(AllocatedHeader));
 }
 
+bool AllocationBlock::allocate(const std::size_t alignment, const std::size_t size, const std::size_t count,
+                               void **objects) noexcept
+{
+    assert(alignment && (!(alignment & (alignment - 1))) && "Alignment must be > 0 and power of 2");
+
+    /**
+     * Every object is placed in a slot of the same size; the header is
+     * placed in front of the object, which starts aligned in the slot.
+     * The region of all slots is carved from the end of a free element.
+     *
+     * +-------------------------------------------------------------+
+     * | free     | unused | header | object | unused | header | ...  |
+     * +-------------------------------------------------------------+
+     *            ^ region begin (aligned)
+     */
+    const auto header_size = alignment_helper::next_multiple(sizeof(AllocatedHeader), alignment);
+    const auto object_size = alignment_helper::next_multiple(size, alignment);
+    const auto slot_size = header_size + object_size;
+    const auto region_size = slot_size * count;
+
+    this->_lock.lock();
+
+    if (this->_available_size < region_size + alignment)
+    {
+        this->_lock.unlock();
+        return false;
+    }
+
+    const auto free_element_iterator = std::find_if(
+        this->_free_elements.begin(), this->_free_elements.end(),
+        [region_size, alignment](const auto &free_element) { return free_element >= region_size + alignment; });
+    if (free_element_iterator == this->_free_elements.end())
+    {
+        this->_lock.unlock();
+        return false;
+    }
+
+    const auto free_block_start = free_element_iterator->start();
+    const auto free_block_end = free_block_start + free_element_iterator->size();
+    const auto region_begin = (free_block_end - region_size) & ~(alignment - 1U);
+
+    std::uint16_t size_before_region{0U};
+    if (region_begin - free_block_start >= 256U)
+    {
+        free_element_iterator->contract(free_block_end - region_begin);
+        this->_available_size -= free_block_end - region_begin;
+    }
+    else
+    {
+        size_before_region = region_begin - free_block_start;
+        this->_available_size -= free_element_iterator->size();
+        this->_free_elements.erase(free_element_iterator);
+    }
+    this->_lock.unlock();
+
+    // The first object owns the rest of the free element in front of the region,
+    // the last object owns the unused memory between the region and the block end.
+    const auto size_after_region = free_block_end - (region_begin + region_size);
+    for (auto i = 0U; i < count; ++i)
+    {
+        const auto object_address = region_begin + i * slot_size + header_size;
+        const auto unused_size_before_header =
+            header_size - sizeof(AllocatedHeader) + (i == 0U ? size_before_region : 0U);
+        const auto allocated_size = object_size + (i == count - 1U ? size_after_region : 0U);
+
+        new (reinterpret_cast<void *>(object_address - sizeof(AllocatedHeader))) AllocatedHeader(
+            allocated_size, std::uint16_t(unused_size_before_header), this->_numa_node_id, this->_id);
+        objects[i] = reinterpret_cast<void *>(object_address);
+    }
+
+    return true;
+}
+
 void AllocationBlock::free(AllocatedHeader *allocation_header) noexcept
 {
     const auto allocated_size = allocation_header->size;
@@ -137,6 +223,30 @@ void AllocationBlock::free(AllocatedHeader *allocation_header) noexcept
     this->_lock.unlock();
 }
 
+std::pair<std::size_t, std::size_t> AllocationBlock::free_size() noexcept
+{
+    auto largest_free_size = std::size_t{0U};
+
+    this->_lock.lock();
+    for (const auto &free_element : this->_free_elements)
+    {
+        largest_free_size = std::max<std::size_t>(largest_free_size, free_element.size());
+    }
+    const auto available_size = this->_available_size;
+    this->_lock.unlock();
+
+    return std::make_pair(available_size, largest_free_size);
+}
+
+std::vector<FreeHeader> AllocationBlock::free_elements() noexcept
+{
+    this->_lock.lock();
+    auto free_elements = this->_free_elements;
+    this->_lock.unlock();
+
+    return free_elements;
+}
+
 std::pair<std::vector<FreeHeader>::iterator, std::size_t> AllocationBlock::find_block(const std::size_t alignment,
                                                                                       const std::size_t size) noexcept
 {
@@ -193,8 +303,32 @@ Allocator::Allocator()
     this->initialize_empty();
 }
 
+Allocator::~Allocator()
+{
+    this->close_persistent_heap();
+}
+
 void *Allocator::allocate(const std::uint8_t numa_node_id, const std::size_t alignment, const std::size_t size) noexcept
 {
+    if (this->_persistent_heap != nullptr)
+    {
+        return this->allocate_persistent(alignment, size);
+    }
+
+    if (SizeClassAllocator::is_size_class(alignment, size))
+    {
+        auto *memory = this->_size_classes.allocate(numa_node_id, size);
+        if (memory != nullptr)
+        {
+            if constexpr (config::allocator_statistics())
+            {
+                this->count(memory, true);
+            }
+
+            return memory;
+        }
+    }
+
     auto &allocation_blocks = this->_numa_allocation_blocks[numa_node_id];
 
     auto *memory = allocation_blocks.back().allocate(alignment, size);
@@ -217,9 +351,257 @@ void *Allocator::allocate(const std::uint8_t numa_node_id, const std::size_t ali
         }
     }
 
+    if constexpr (config::allocator_statistics())
+    {
+        this->count(memory, true);
+    }
+
+    return memory;
+}
+
+void Allocator::allocate(const std::uint8_t numa_node_id, const std::size_t alignment, const std::size_t size,
+                         const std::size_t count, void **objects) noexcept
+{
+    if (this->_persistent_heap != nullptr)
+    {
+        if (this->_persistent_heap->allocate(alignment, size, count, objects) == false)
+        {
+            std::fill(objects, objects + count, nullptr);
+            return;
+        }
+    }
+    else if (auto &allocation_blocks = this->_numa_allocation_blocks[numa_node_id];
+             allocation_blocks.back().allocate(alignment, size, count, objects) == false)
+    {
+        constexpr auto default_alloc_size = 1UL << 28U;
+
+        // Upper bound of the region needed for all objects, including headers and alignment.
+        const auto needed_size = count * (alignment_helper::next_multiple(size, alignment) +
+                                          alignment_helper::next_multiple(sizeof(AllocatedHeader), alignment)) +
+                                 alignment;
+        const auto size_to_alloc = std::max(default_alloc_size, alignment_helper::next_multiple(needed_size, 64UL));
+
+        auto &flag = this->_numa_allocation_flags[numa_node_id].value();
+        do
+        {
+            allocate_new_block(numa_node_id, size_to_alloc, allocation_blocks, flag);
+        } while (allocation_blocks.back().allocate(alignment, size, count, objects) == false);
+    }
+
+    if constexpr (config::allocator_statistics())
+    {
+        for (auto i = 0U; i < count; ++i)
+        {
+            this->count(objects[i], true);
+        }
+    }
+}
+
+void *Allocator::allocate_interleaved(const std::size_t alignment, const std::size_t size) noexcept
+{
+    const auto mapped_size = Allocator::mapped_offset(alignment) + size;
+    auto *mapped_memory = GlobalHeap::allocate_interleaved(mapped_size);
+    if (mapped_memory == nullptr)
+    {
+        return nullptr;
+    }
+
+    this->_count_mapped_objects.fetch_add(1U, std::memory_order_relaxed);
+    auto *memory = Allocator::place_mapped(mapped_memory, mapped_size, alignment, INTERLEAVED);
+    if constexpr (config::allocator_statistics())
+    {
+        this->count(memory, true);
+    }
+
+    return memory;
+}
+
+void *Allocator::allocate_replicated(const std::uint8_t numa_node_id, const std::size_t alignment,
+                                     const std::size_t size) noexcept
+{
+    const auto mapped_size = Allocator::mapped_offset(alignment) + size;
+
+    auto replica_table = ReplicaTable{};
+    const auto max_numa_node_id =
+        std::min<std::uint32_t>(system::topology::max_node_id(), config::max_numa_nodes() - 1U);
+    for (auto replica_numa_node_id = 0U; replica_numa_node_id <= max_numa_node_id; ++replica_numa_node_id)
+    {
+        auto *mapped_memory = GlobalHeap::allocate(std::uint8_t(replica_numa_node_id), mapped_size);
+        if (mapped_memory == nullptr)
+        {
+            // Either all replicas are allocated or none.
+            for (auto *replica : replica_table.replicas)
+            {
+                if (replica != nullptr)
+                {
+                    GlobalHeap::free(this->replicas(replica), mapped_size);
+                }
+            }
+            return nullptr;
+        }
+
+        replica_table.replicas[replica_numa_node_id] =
+            Allocator::place_mapped(mapped_memory, mapped_size, alignment, REPLICATED);
+    }
+
+    // Every replica knows all replicas, so that they are found by node-local reads.
+    for (auto *replica : replica_table.replicas)
+    {
+        if (replica != nullptr)
+        {
+            *this->replicas(replica) = replica_table;
+        }
+    }
+
+    this->_count_mapped_objects.fetch_add(1U, std::memory_order_relaxed);
+    if constexpr (config::allocator_statistics())
+    {
+        this->count(replica_table.replicas[0U], true);
+    }
+
+    return this->replica(replica_table.replicas[0U], numa_node_id);
+}
+
+void *Allocator::allocate_persistent(const std::size_t alignment, const std::size_t size) noexcept
+{
+    auto *memory = this->_persistent_heap->allocate(alignment, size);
+    if constexpr (config::allocator_statistics())
+    {
+        if (memory != nullptr)
+        {
+            this->count(memory, true);
+        }
+    }
+
     return memory;
 }
 
+bool Allocator::open_persistent_heap(const std::string &path, const std::size_t size)
+{
+    this->close_persistent_heap();
+
+    auto *persistent_heap = new PersistentHeap(path, size, PERSISTENT);
+    if (persistent_heap->is_open() == false)
+    {
+        delete persistent_heap;
+        return false;
+    }
+
+    this->_persistent_heap = persistent_heap;
+    return persistent_heap->is_restored();
+}
+
+void Allocator::close_persistent_heap()
+{
+    delete std::exchange(this->_persistent_heap, nullptr);
+}
+
+void *Allocator::persistent_root() const noexcept
+{
+    return this->_persistent_heap != nullptr ? this->_persistent_heap->root() : nullptr;
+}
+
+void Allocator::persistent_root(void *root) noexcept
+{
+    if (this->_persistent_heap != nullptr)
+    {
+        this->_persistent_heap->root(root);
+    }
+}
+
+ReplicaTable *Allocator::replicas(void *pointer) const noexcept
+{
+    if (this->_size_classes.contains(pointer))
+    {
+        return nullptr;
+    }
+
+    const auto header_address = reinterpret_cast<std::uintptr_t>(pointer) - sizeof(AllocatedHeader);
+    const auto *allocation_header = reinterpret_cast<AllocatedHeader *>(header_address);
+    if (allocation_header->numa_node_id != REPLICATED)
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<ReplicaTable *>(header_address - allocation_header->unused_size_before_header);
+}
+
+void Allocator::count(void *pointer, const bool is_allocation) noexcept
+{
+    auto size = std::size_t{0U};
+    auto numa_node_id = std::uint8_t{0U};
+    if (this->_size_classes.contains(pointer))
+    {
+        size = this->_size_classes.object_size(pointer);
+        numa_node_id = this->_size_classes.numa_node_id(pointer);
+    }
+    else
+    {
+        const auto *allocation_header =
+            reinterpret_cast<AllocatedHeader *>(reinterpret_cast<std::uintptr_t>(pointer) - sizeof(AllocatedHeader));
+        size = allocation_header->size;
+        numa_node_id = allocation_header->numa_node_id;
+    }
+
+    // Interleaved and replicated objects are never remote.
+    const auto core_id = system::topology::core_id();
+    const auto is_remote =
+        numa_node_id < config::max_numa_nodes() && numa_node_id != system::topology::node_id(core_id);
+
+    if (is_allocation)
+    {
+        this->_statistic.add<Statistic::AllocatedObjects>();
+        this->_statistic.add<Statistic::AllocatedBytes>(size);
+        this->_statistic.add<Statistic::RemoteAllocations>(is_remote);
+    }
+    else
+    {
+        this->_statistic.add<Statistic::FreedObjects>();
+        this->_statistic.add<Statistic::FreedBytes>(size);
+        this->_statistic.add<Statistic::RemoteFrees>(is_remote);
+    }
+}
+
+mx::memory::NodeStatistic Allocator::statistic(const std::uint8_t numa_node_id) noexcept
+{
+    auto statistic = NodeStatistic{};
+    statistic.count_free_objects = this->_size_classes.count_free_objects(numa_node_id);
+
+    // Blocks are not added meanwhile.
+    auto &flag = this->_numa_allocation_flags[numa_node_id].value();
+    auto expected = false;
+    while (flag.compare_exchange_weak(expected, true) == false)
+    {
+        expected = false;
+        system::builtin::pause();
+    }
+
+    for (auto &block : this->_numa_allocation_blocks[numa_node_id])
+    {
+        const auto [free_size, largest_free_size] = block.free_size();
+        ++statistic.count_chunks;
+        statistic.reserved_bytes += block.size();
+        statistic.free_bytes += free_size;
+        statistic.largest_free_block = std::max<std::uint64_t>(statistic.largest_free_block, largest_free_size);
+    }
+
+    flag.store(false);
+
+    return statistic;
+}
+
+void *Allocator::place_mapped(void *memory, const std::size_t mapped_size, const std::size_t alignment,
+                              const std::uint8_t marker) noexcept
+{
+    const auto object_address = reinterpret_cast<std::uintptr_t>(memory) + Allocator::mapped_offset(alignment);
+    const auto unused_size_before_header = Allocator::mapped_offset(alignment) - sizeof(AllocatedHeader);
+
+    new (reinterpret_cast<void *>(object_address - sizeof(AllocatedHeader)))
+        AllocatedHeader(mapped_size, std::uint16_t(unused_size_before_header), marker, 0U);
+
+    return reinterpret_cast<void *>(object_address);
+}
+
 void Allocator::allocate_new_block(const std::uint8_t numa_node_id, const std::size_t size,
                                    std::vector<AllocationBlock> &blocks, std::atomic<bool> &flag)
 {
@@ -248,6 +630,17 @@ void Allocator::allocate_new_block(const std::uint8_t numa_node_id, const std::s
 
 void Allocator::free(void *pointer) noexcept
 {
+    if constexpr (config::allocator_statistics())
+    {
+        this->count(pointer, false);
+    }
+
+    if (this->_size_classes.contains(pointer))
+    {
+        this->_size_classes.free(pointer);
+        return;
+    }
+
     // Every allocated memory belongs to one allocation block.
     // The reason is, that we can only return full blocks to
     // the global heap that is managed by the operating system.
@@ -257,6 +650,36 @@ void Allocator::free(void *pointer) noexcept
     const auto header_address = address - sizeof(AllocatedHeader);
     auto *allocation_header = reinterpret_cast<AllocatedHeader *>(header_address);
 
+    // Interleaved and replicated objects are mapped from the global heap.
+    if (allocation_header->numa_node_id == INTERLEAVED)
+    {
+        GlobalHeap::free(reinterpret_cast<void *>(header_address - allocation_header->unused_size_before_header),
+                         allocation_header->size);
+        this->_count_mapped_objects.fetch_sub(1U, std::memory_order_relaxed);
+        return;
+    }
+
+    if (allocation_header->numa_node_id == PERSISTENT)
+    {
+        this->_persistent_heap->free(allocation_header);
+        return;
+    }
+
+    if (allocation_header->numa_node_id == REPLICATED)
+    {
+        const auto replica_table = *this->replicas(pointer);
+        const auto mapped_size = allocation_header->size;
+        for (auto *replica : replica_table.replicas)
+        {
+            if (replica != nullptr)
+            {
+                GlobalHeap::free(this->replicas(replica), mapped_size);
+            }
+        }
+        this->_count_mapped_objects.fetch_sub(1U, std::memory_order_relaxed);
+        return;
+    }
+
     // Check all blocks to find the matching one.
     for (auto &block : this->_numa_allocation_blocks[allocation_header->numa_node_id])
     {
@@ -298,8 +721,13 @@ void Allocator::initialize_empty()
     }
 }
 
-bool Allocator::is_free() const noexcept
+bool Allocator::is_free() noexcept
 {
+    if (this->_size_classes.is_free() == false || this->_count_mapped_objects.load(std::memory_order_relaxed) > 0U)
+    {
+        return false;
+    }
+
     for (auto i = 0U; i <= system::topology::max_node_id(); ++i)
     {
         const auto &numa_blocks = this->_numa_allocation_blocks[i];
@@ -318,6 +746,8 @@ bool Allocator::is_free() const noexcept
 
 void Allocator::release_allocated_memory() noexcept
 {
+    this->_size_classes.reset();
+
     for (auto i = 0U; i <= system::topology::max_node_id(); ++i)
     {
         this->_numa_allocation_blocks[i].clear();
@@ -1,15 +1,23 @@
 #pragma once
 
+#include "alignment_helper.h"
 #include "config.h"
+#include "size_class_allocator.h"
+#include "statistic.h"
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdint>
+#include <limits>
 #include <mx/synchronization/spinlock.h>
 #include <mx/util/aligned_t.h>
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace mx::memory::dynamic {
+class PersistentHeap;
 
 /**
  * Represents free space within an allocation block.
@@ -72,6 +80,15 @@ struct AllocatedHeader
     const std::uint32_t allocation_block_id;
 };
 
+/**
+ * Table of the replicas of a replicated object, placed in
+ * front of every replica; one replica per NUMA node.
+ */
+struct ReplicaTable
+{
+    std::array<void *, config::max_numa_nodes()> replicas{nullptr};
+};
+
 /**
  * Set of on or more free tiles, that can be allocated.
  */
@@ -79,6 +96,19 @@ class AllocationBlock
 {
 public:
     AllocationBlock(std::uint32_t id, std::uint8_t numa_node_id, std::size_t size);
+
+    /**
+     * Creates an allocation block on memory owned by someone else (e.g., a mapped file),
+     * which is not freed with the block.
+     *
+     * @param id Unique number of the block.
+     * @param numa_node_id NUMA node (or marker) written to the header of allocated memory.
+     * @param memory Memory of the block.
+     * @param size Size of the memory.
+     * @param free_elements Free regions of the memory.
+     */
+    AllocationBlock(std::uint32_t id, std::uint8_t numa_node_id, void *memory, std::size_t size,
+                    std::vector<FreeHeader> &&free_elements);
     AllocationBlock(const AllocationBlock &other) = delete;
     AllocationBlock(AllocationBlock &&other) noexcept;
     AllocationBlock &operator=(AllocationBlock &&other) noexcept;
@@ -93,6 +123,18 @@ public:
      */
     void *allocate(std::size_t alignment, std::size_t size) noexcept;
 
+    /**
+     * Allocates a set of objects from one contiguous region of the allocation block.
+     * Every object gets its own header and can be freed separately.
+     *
+     * @param alignment Requested alignment of every object.
+     * @param size Requested size of every object.
+     * @param count Number of objects.
+     * @param objects Array receiving the pointers to the allocated objects.
+     * @return True, if all objects were allocated; false, if the block has no region of the requested size.
+     */
+    bool allocate(std::size_t alignment, std::size_t size, std::size_t count, void **objects) noexcept;
+
     /**
      * Frees memory.
      *
@@ -105,6 +147,21 @@ public:
      */
     [[nodiscard]] std::uint32_t id() const noexcept { return _id; }
 
+    /**
+     * @return Size of this allocation block.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return _size; }
+
+    /**
+     * @return Pair of the free size and the size of the largest free region.
+     */
+    [[nodiscard]] std::pair<std::size_t, std::size_t> free_size() noexcept;
+
+    /**
+     * @return Copy of the free regions.
+     */
+    [[nodiscard]] std::vector<FreeHeader> free_elements() noexcept;
+
     /**
      * @return True, if the full block is free.
      */
@@ -121,6 +178,9 @@ private:
     void *_allocated_block;
     std::vector<FreeHeader> _free_elements;
 
+    // False, when the memory is owned by someone else.
+    bool _is_owner{true};
+
     alignas(64) std::size_t _available_size;
     synchronization::Spinlock _lock;
 
@@ -130,17 +190,144 @@ private:
 
 /**
  * Allocator which holds a set of allocation blocks separated
- * for each numa node region.
+ * for each numa node region. Small objects are served by size
+ * classes with per-core caches; allocation blocks are used for
+ * large objects or objects with an unusual alignment.
  */
 class Allocator
 {
 public:
     Allocator();
-    ~Allocator() = default;
+    ~Allocator();
 
     void *allocate(std::uint8_t numa_node_id, std::size_t alignment, std::size_t size) noexcept;
+
+    /**
+     * Allocates an object of the given type. Small types are served by
+     * a pool of their own, without header and padding.
+     *
+     * @param numa_node_id NUMA region to allocate the object in.
+     * @param size Size of the object, at least the size of the type.
+     * @return Pointer to the allocated memory.
+     */
+    template <typename T> void *allocate(const std::uint8_t numa_node_id, const std::size_t size = sizeof(T)) noexcept
+    {
+        if constexpr (SizeClassAllocator::is_size_class(alignof(T), sizeof(T)))
+        {
+            // Pools are not persistent and hold objects of the size of the type, rounded to the cache line.
+            const auto is_pooled = this->_persistent_heap == nullptr &&
+                                   size <= alignment_helper::next_multiple(sizeof(T), std::size_t(64U));
+            auto *memory = is_pooled ? this->_size_classes.allocate<T>(numa_node_id) : nullptr;
+            if (memory != nullptr)
+            {
+                if constexpr (config::allocator_statistics())
+                {
+                    this->count(memory, true);
+                }
+
+                return memory;
+            }
+        }
+
+        return this->allocate(numa_node_id, std::max<std::size_t>(alignof(T), 64U), std::max(size, sizeof(T)));
+    }
+
+    /**
+     * Allocates an object whose pages are interleaved over all NUMA
+     * regions, which spreads accesses over all memory controllers.
+     * The object is mapped from the global heap, which suits large objects.
+     *
+     * @param alignment Alignment of the object.
+     * @param size Size of the object.
+     * @return Pointer to the allocated memory; nullptr, when the memory could not be allocated.
+     */
+    void *allocate_interleaved(std::size_t alignment, std::size_t size) noexcept;
+
+    /**
+     * Allocates one replica of an object on every NUMA region, e.g., for read-mostly
+     * objects accessed from all regions. Replicas are mapped from the global heap,
+     * which suits large objects. Freeing any replica frees all of them.
+     *
+     * @param numa_node_id NUMA region of the returned replica.
+     * @param alignment Alignment of every replica.
+     * @param size Size of every replica.
+     * @return Pointer to the replica on the given NUMA region; nullptr, when any replica could not be allocated.
+     */
+    void *allocate_replicated(std::uint8_t numa_node_id, std::size_t alignment, std::size_t size) noexcept;
+
+    /**
+     * @param pointer Pointer to memory allocated by this allocator.
+     * @return Table of all replicas; nullptr, when the memory is not replicated.
+     */
+    [[nodiscard]] ReplicaTable *replicas(void *pointer) const noexcept;
+
+    /**
+     * @param pointer Pointer to memory allocated by this allocator.
+     * @param numa_node_id NUMA region.
+     * @return The replica on the given NUMA region; the memory itself, when not replicated.
+     */
+    [[nodiscard]] void *replica(void *pointer, const std::uint8_t numa_node_id) const noexcept
+    {
+        const auto *replica_table = this->replicas(pointer);
+        if (replica_table != nullptr && numa_node_id < config::max_numa_nodes() &&
+            replica_table->replicas[numa_node_id] != nullptr)
+        {
+            return replica_table->replicas[numa_node_id];
+        }
+
+        return pointer;
+    }
+
+    /**
+     * Allocates a set of objects at once, contiguous within one allocation block.
+     *
+     * @param numa_node_id NUMA region to allocate the objects in.
+     * @param alignment Alignment of every object.
+     * @param size Size of every object.
+     * @param count Number of objects.
+     * @param objects Array receiving the pointers to the allocated objects.
+     */
+    void allocate(std::uint8_t numa_node_id, std::size_t alignment, std::size_t size, std::size_t count,
+                  void **objects) noexcept;
+
     void free(void *pointer) noexcept;
 
+    /**
+     * Backs all further allocations (but interleaved and replicated ones) by a heap in
+     * the given file, which outlives the process (see PersistentHeap). The heap of a
+     * previous run is restored, if it was closed. Objects on the heap are neither
+     * considered by is_free() nor released by release_allocated_memory().
+     * Must not be called while objects are allocated.
+     *
+     * @param path File of the heap.
+     * @param size Size of the heap.
+     * @return True, if the heap of a previous run was restored.
+     */
+    bool open_persistent_heap(const std::string &path, std::size_t size);
+
+    /**
+     * Writes and unmaps the persistent heap; objects on the heap become invalid.
+     * Further allocations are volatile.
+     */
+    void close_persistent_heap();
+
+    /**
+     * @return True, if allocations are backed by a persistent heap.
+     */
+    [[nodiscard]] bool is_persistent() const noexcept { return _persistent_heap != nullptr; }
+
+    /**
+     * @return Entry point stored in the persistent heap; nullptr, if none.
+     */
+    [[nodiscard]] void *persistent_root() const noexcept;
+
+    /**
+     * Stores the entry point (e.g., the root of a data structure) in the persistent heap.
+     *
+     * @param root Object on the persistent heap.
+     */
+    void persistent_root(void *root) noexcept;
+
     /**
      * Frees unused allocation blocks.
      */
@@ -159,9 +346,39 @@ public:
     /**
      * @return True, if all blocks of all numa regions are free.
      */
-    [[nodiscard]] bool is_free() const noexcept;
+    [[nodiscard]] bool is_free() noexcept;
+
+    /**
+     * @return Counters of allocated and freed objects per core.
+     */
+    [[nodiscard]] const Statistic &statistic() const noexcept { return _statistic; }
+
+    /**
+     * @param numa_node_id NUMA region.
+     * @return State of the allocation blocks and size classes on the given NUMA region.
+     */
+    [[nodiscard]] NodeStatistic statistic(std::uint8_t numa_node_id) noexcept;
 
 private:
+    // Markers in the header of objects mapped from the global heap, instead of the NUMA node.
+    inline static constexpr auto INTERLEAVED = std::numeric_limits<std::uint8_t>::max();
+    inline static constexpr auto REPLICATED = std::uint8_t(INTERLEAVED - 1U);
+
+    // Marker in the header of objects on the persistent heap.
+    inline static constexpr auto PERSISTENT = std::uint8_t(INTERLEAVED - 2U);
+
+    // Front end for small objects.
+    SizeClassAllocator _size_classes;
+
+    // Number of interleaved and replicated objects in use.
+    alignas(64) std::atomic_uint64_t _count_mapped_objects{0U};
+
+    // Counters of allocated and freed objects.
+    Statistic _statistic;
+
+    // Heap backing all allocations, if opened.
+    PersistentHeap *_persistent_heap{nullptr};
+
     // Allocation blocks per numa node region.
     std::array<std::vector<AllocationBlock>, config::max_numa_nodes()> _numa_allocation_blocks;
 
@@ -180,6 +397,45 @@ private:
      */
     void allocate_new_block(std::uint8_t numa_node_id, std::size_t size, std::vector<AllocationBlock> &blocks,
                             std::atomic<bool> &flag);
+
+    /**
+     * Allocates memory from the persistent heap.
+     *
+     * @param alignment Requested alignment.
+     * @param size Requested size.
+     * @return Pointer to the allocated memory; nullptr, when the heap is exhausted.
+     */
+    void *allocate_persistent(std::size_t alignment, std::size_t size) noexcept;
+
+    /**
+     * Counts an allocated or freed object.
+     *
+     * @param pointer Pointer to the object.
+     * @param is_allocation True, if the object was allocated; false, if it will be freed.
+     */
+    void count(void *pointer, bool is_allocation) noexcept;
+
+    /**
+     * Places the header of an object mapped from the global heap. Mapped memory
+     * starts with the replica table, followed by the header and the object.
+     *
+     * @param memory Mapped memory.
+     * @param mapped_size Size of the mapped memory.
+     * @param alignment Alignment of the object.
+     * @param marker Marker of the mapping (INTERLEAVED or REPLICATED).
+     * @return Pointer to the object.
+     */
+    static void *place_mapped(void *memory, std::size_t mapped_size, std::size_t alignment,
+                              std::uint8_t marker) noexcept;
+
+    /**
+     * @param alignment Alignment of the object.
+     * @return Offset of a mapped object from the start of the mapped memory.
+     */
+    [[nodiscard]] static std::size_t mapped_offset(const std::size_t alignment) noexcept
+    {
+        return alignment_helper::next_multiple(sizeof(ReplicaTable) + sizeof(AllocatedHeader), alignment);
+    }
 };
 
 } // namespace mx::memory::dynamic
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "alignment_helper.h"
 #include "config.h"
 #include "global_heap.h"
+#include "statistic.h"
 #include "task_allocator_interface.h"
 #include <array>
 #include <atomic>
@@ -38,8 +39,129 @@ private:
     std::uint8_t _numa_node_id = 0U;
 };
 
+/**
+ * The ChunkHeader is placed at the start of every chunk and
+ * identifies the core (and NUMA region) the objects of the
+ * chunk belong to.
+ * Further, the header holds the free objects of the chunk
+ * and links the chunk into the list of chunks of its core,
+ * that have free objects left.
+ * Objects never used before are carved from the chunk by
+ * a bump pointer; thus, the pages of a chunk are touched
+ * not before the objects are needed.
+ */
+class ChunkHeader
+{
+public:
+    /**
+     * @param core_id Core the objects of the chunk belong to.
+     * @param numa_node_id NUMA region the chunk is allocated on.
+     * @param object_size Size of every object.
+     * @param chunk_size Size of the chunk.
+     */
+    ChunkHeader(const std::uint16_t core_id, const std::uint8_t numa_node_id, const std::uint32_t object_size,
+                const std::size_t chunk_size) noexcept
+        : _core_id(core_id), _numa_node_id(numa_node_id), _object_size(object_size),
+          _next_unused_object(reinterpret_cast<std::uintptr_t>(this) + object_size),
+          _end(reinterpret_cast<std::uintptr_t>(this) + (chunk_size / object_size) * object_size)
+    {
+    }
+
+    ~ChunkHeader() noexcept = default;
+
+    /**
+     * @return ID of the core the objects of the chunk belong to.
+     */
+    [[nodiscard]] std::uint16_t core_id() const noexcept { return _core_id; }
+
+    /**
+     * @return ID of the NUMA region the chunk is allocated on.
+     */
+    [[nodiscard]] std::uint8_t numa_node_id() const noexcept { return _numa_node_id; }
+
+    /**
+     * @return A free object of the chunk; nullptr, when all objects are in use.
+     */
+    [[nodiscard]] void *allocate() noexcept
+    {
+        auto *free_object = _first_free;
+        if (free_object != nullptr)
+        {
+            _first_free = free_object->next();
+        }
+        else if (_next_unused_object < _end)
+        {
+            free_object = reinterpret_cast<FreeHeader *>(_next_unused_object);
+            _next_unused_object += _object_size;
+        }
+        else
+        {
+            return nullptr;
+        }
+
+        ++_count_used_objects;
+        return static_cast<void *>(free_object);
+    }
+
+    /**
+     * Returns an object to the chunk.
+     *
+     * @param pointer Pointer to the memory object to be freed.
+     */
+    void free(void *pointer) noexcept
+    {
+        auto *free_object = static_cast<FreeHeader *>(pointer);
+        free_object->next(_first_free);
+        _first_free = free_object;
+        --_count_used_objects;
+    }
+
+    /**
+     * @return True, when all objects of the chunk are in use.
+     */
+    [[nodiscard]] bool is_full() const noexcept { return _first_free == nullptr && _next_unused_object == _end; }
+
+    /**
+     * @return True, when no object of the chunk is in use.
+     */
+    [[nodiscard]] bool is_empty() const noexcept { return _count_used_objects == 0U; }
+
+    [[nodiscard]] ChunkHeader *previous() const noexcept { return _previous; }
+    void previous(ChunkHeader *previous) noexcept { _previous = previous; }
+    [[nodiscard]] ChunkHeader *next() const noexcept { return _next; }
+    void next(ChunkHeader *next) noexcept { _next = next; }
+
+private:
+    // Core the objects of this chunk belong to.
+    const std::uint16_t _core_id;
+
+    // NUMA region the chunk is allocated on.
+    const std::uint8_t _numa_node_id;
+
+    // Number of objects allocated and not freed.
+    std::uint32_t _count_used_objects{0U};
+
+    // Size of every object.
+    const std::uint32_t _object_size;
+
+    // List of freed objects.
+    FreeHeader *_first_free{nullptr};
+
+    // Next object that was never used.
+    std::uintptr_t _next_unused_object;
+
+    // End of the last object in the chunk.
+    const std::uintptr_t _end;
+
+    // Neighbours in the list of chunks with free objects.
+    ChunkHeader *_previous{nullptr};
+    ChunkHeader *_next{nullptr};
+};
+
 /**
  * The Chunk holds a fixed size of memory.
+ * Chunks are aligned to their size, so that the
+ * chunk of every object can be found by its address.
  */
 class Chunk
 {
@@ -50,6 +172,15 @@ public:
 
     static constexpr auto size() { return 4096 * 4096; /* 16mb */ }
 
+    /**
+     * @param object Object allocated from a chunk.
+     * @return Header of the chunk the object was allocated from.
+     */
+    [[nodiscard]] static ChunkHeader *header(const void *object) noexcept
+    {
+        return reinterpret_cast<ChunkHeader *>(reinterpret_cast<std::uintptr_t>(object) & ~std::uintptr_t(size() - 1));
+    }
+
     explicit operator void *() const noexcept { return _memory; }
     explicit operator std::uintptr_t() const noexcept { return reinterpret_cast<std::uintptr_t>(_memory); }
     explicit operator bool() const noexcept { return _memory != nullptr; }
@@ -99,6 +230,11 @@ public:
         _next_free_chunk.store(other._next_free_chunk.load());
         _fill_buffer_flag.store(other._fill_buffer_flag.load());
         _allocated_chunks = std::move(other._allocated_chunks);
+        _count_free_chunks.store(other._count_free_chunks.exchange(0U));
+        _count_reserved_chunks.store(other._count_reserved_chunks.exchange(0U));
+        _count_taken_chunks.store(other._count_taken_chunks.exchange(0U));
+        _free_chunks = std::move(other._free_chunks);
+        _trimmed_chunks = std::move(other._trimmed_chunks);
         return *this;
     }
 
@@ -108,17 +244,34 @@ public:
     [[nodiscard]] std::uint8_t numa_node_id() const noexcept { return _numa_node_id; }
 
     /**
-     * Allocates a chunk of memory from the internal buffer.
-     * In case the buffer is empty, new Chunks from the GlobalHeap
-     * will be allocated.
+     * Allocates a chunk of memory. Chunks given back by cores
+     * are reused first; otherwise, the chunk is taken from the
+     * internal buffer. In case the buffer is empty, new Chunks
+     * from the GlobalHeap will be allocated.
      *
-     * @return A chunk of allocated memory.
+     * @return A chunk of allocated memory; an empty chunk, when no memory could be reserved.
      */
     Chunk allocate() noexcept
     {
+        if (_count_free_chunks.load(std::memory_order_relaxed) > 0U)
+        {
+            _free_chunks_lock.lock();
+            auto &free_chunks = _free_chunks.empty() ? _trimmed_chunks : _free_chunks;
+            if (free_chunks.empty() == false)
+            {
+                const auto chunk = free_chunks.back();
+                free_chunks.pop_back();
+                _count_free_chunks.fetch_sub(1U, std::memory_order_relaxed);
+                _free_chunks_lock.unlock();
+                return chunk;
+            }
+            _free_chunks_lock.unlock();
+        }
+
         const auto next_free_chunk = _next_free_chunk.fetch_add(1, std::memory_order_relaxed);
         if (next_free_chunk < _free_chunk_buffer.size())
         {
+            _count_taken_chunks.fetch_add(1U, std::memory_order_relaxed);
             return _free_chunk_buffer[next_free_chunk];
         }
 
@@ -126,8 +279,12 @@ public:
         const auto can_fill = _fill_buffer_flag.compare_exchange_strong(expect, true);
         if (can_fill)
         {
-            fill_buffer<false>();
+            const auto is_filled = fill_buffer<false>();
             _fill_buffer_flag = false;
+            if (is_filled == false)
+            {
+                return Chunk{};
+            }
         }
         else
         {
@@ -140,6 +297,62 @@ public:
         return allocate();
     }
 
+    /**
+     * Gives back a chunk, that is not used any more.
+     * The chunk is kept for reuse until trim() releases its memory.
+     *
+     * @param chunk Chunk without any object in use.
+     */
+    void free(const Chunk chunk) noexcept
+    {
+        _free_chunks_lock.lock();
+        _free_chunks.push_back(chunk);
+        _count_free_chunks.fetch_add(1U, std::memory_order_relaxed);
+        _free_chunks_lock.unlock();
+    }
+
+    /**
+     * Releases the physical memory of all given back chunks to the
+     * operating system. The chunks stay mapped and can be reused.
+     */
+    void trim() noexcept
+    {
+        if (_count_free_chunks.load(std::memory_order_relaxed) == 0U)
+        {
+            return;
+        }
+
+        _free_chunks_lock.lock();
+        auto chunks = std::move(_free_chunks);
+        _free_chunks.clear();
+        _count_free_chunks.fetch_sub(chunks.size(), std::memory_order_relaxed);
+        _free_chunks_lock.unlock();
+
+        // Releasing memory is expensive; do not block cores meanwhile.
+        for (const auto chunk : chunks)
+        {
+            GlobalHeap::release(static_cast<void *>(chunk), Chunk::size());
+        }
+
+        _free_chunks_lock.lock();
+        _trimmed_chunks.insert(_trimmed_chunks.end(), chunks.begin(), chunks.end());
+        _count_free_chunks.fetch_add(chunks.size(), std::memory_order_relaxed);
+        _free_chunks_lock.unlock();
+    }
+
+    /**
+     * @return State of the chunks of this ProcessorHeap.
+     */
+    [[nodiscard]] NodeStatistic statistic() const noexcept
+    {
+        auto statistic = NodeStatistic{};
+        const auto count_free_chunks = _count_free_chunks.load(std::memory_order_relaxed);
+        statistic.reserved_bytes = _count_reserved_chunks.load(std::memory_order_relaxed) * Chunk::size();
+        statistic.count_chunks = _count_taken_chunks.load(std::memory_order_relaxed) - count_free_chunks;
+        statistic.count_free_chunks = count_free_chunks;
+        return statistic;
+    }
+
 private:
     // Size of the internal chunk buffer.
     inline static constexpr auto CHUNKS = 128U;
@@ -159,22 +372,53 @@ private:
     // List of all allocated chunks, they will be freed later.
     std::vector<Chunk> _allocated_chunks;
 
+    // Number of given back chunks (trimmed or not).
+    alignas(64) std::atomic_uint32_t _count_free_chunks{0U};
+
+    // Latch for the lists of given back chunks.
+    synchronization::Spinlock _free_chunks_lock;
+
+    // Chunks given back by cores, that still hold physical memory.
+    std::vector<Chunk> _free_chunks;
+
+    // Chunks given back by cores, whose physical memory was released.
+    std::vector<Chunk> _trimmed_chunks;
+
+    // Number of chunks reserved from the global heap and taken by cores from the buffer.
+    std::atomic_uint64_t _count_reserved_chunks{0U};
+    std::atomic_uint64_t _count_taken_chunks{0U};
+
     /**
      * Allocates a very big chunk from the GlobalHeap and
      * splits it into smaller chunks to store them in the
      * internal buffer.
+     *
+     * @return True, when the buffer was filled; false, when no memory could be reserved.
      */
-    template <bool IS_FIRST = false> void fill_buffer() noexcept
+    template <bool IS_FIRST = false> bool fill_buffer() noexcept
     {
+        // Chunks are only reserved; pages are committed on this NUMA
+        // node when touched, even when the touching core is remote.
+        auto *heap_memory = GlobalHeap::reserve(Chunk::size(), Chunk::size() * _free_chunk_buffer.size());
+        if (heap_memory == nullptr)
+        {
+            // The buffer holds no chunks to hand out; the next allocation tries again.
+            _next_free_chunk.store(std::uint8_t(CHUNKS));
+            return false;
+        }
+
         if constexpr (IS_FIRST == false)
         {
             for (const auto &chunk : _free_chunk_buffer)
             {
-                _allocated_chunks.push_back(chunk);
+                if (static_cast<bool>(chunk))
+                {
+                    _allocated_chunks.push_back(chunk);
+                }
             }
         }
 
-        auto *heap_memory = GlobalHeap::allocate(_numa_node_id, Chunk::size() * _free_chunk_buffer.size());
+        numa_tonode_memory(heap_memory, Chunk::size() * _free_chunk_buffer.size(), _numa_node_id);
         auto heap_memory_address = reinterpret_cast<std::uintptr_t>(heap_memory);
         for (auto i = 0U; i < _free_chunk_buffer.size(); ++i)
         {
@@ -182,93 +426,314 @@ private:
         }
 
         _next_free_chunk.store(0U);
+        _count_reserved_chunks.fetch_add(_free_chunk_buffer.size(), std::memory_order_relaxed);
+        return true;
     }
 };
 
 /**
- * The CoreHeap represents the allocator on a single core.
- * By this, allocations are latch-free.
+ * The CoreHeap represents the allocator on a single core for a
+ * single NUMA region; every core owns a CoreHeap for its own and
+ * for every remote region. By this, allocations are latch-free.
+ * A CoreHeap takes chunks not before the core allocates from it;
+ * thus, heaps of regions a core never spawns tasks for hold no
+ * memory. Objects freed by other cores are collected by those
+ * cores and returned in batches through a latch-free list, so
+ * that objects stay at the core (and NUMA region) they were
+ * allocated from.
+ * Free objects are kept per chunk. Thus, chunks without any
+ * object in use are recognized and, beyond a few cached ones,
+ * given back to the ProcessorHeap, which releases their memory.
  */
 template <std::size_t S> class alignas(64) CoreHeap
 {
+    static_assert(sizeof(ChunkHeader) <= S, "The chunk header has to fit into a single object.");
+
 public:
-    explicit CoreHeap(ProcessorHeap *processor_heap) noexcept : _processor_heap(processor_heap) { fill_buffer(); }
+    CoreHeap(ProcessorHeap *processor_heap, const std::uint16_t core_id) noexcept
+        : _processor_heap(processor_heap), _core_id(core_id), _numa_node_id(processor_heap->numa_node_id())
+    {
+    }
 
     CoreHeap() noexcept = default;
 
     ~CoreHeap() noexcept = default;
 
+    CoreHeap &operator=(CoreHeap &&other) noexcept
+    {
+        _processor_heap = std::exchange(other._processor_heap, nullptr);
+        _core_id = other._core_id;
+        _numa_node_id = other._numa_node_id;
+        _chunk = std::exchange(other._chunk, nullptr);
+        _available_chunks = std::exchange(other._available_chunks, nullptr);
+        _count_empty_chunks = std::exchange(other._count_empty_chunks, 0U);
+        _remote_batches = other._remote_batches;
+        other._remote_batches.fill(RemoteBatch{});
+        _count_pending_batches = std::exchange(other._count_pending_batches, 0U);
+        _returned.store(other._returned.exchange(nullptr));
+        return *this;
+    }
+
     /**
      * Allocates new memory from the CoreHeap.
-     * When the internal buffer is empty, the CoreHeap
-     * will allocate new chunks from the ProcessorHeap.
+     * When the current chunk is full, the CoreHeap takes objects
+     * returned by other cores, continues with another chunk with
+     * free objects, or will allocate a new chunk from the ProcessorHeap.
+     * The first chunk is allocated by the first allocation, i.e.,
+     * by the owning core, and not when the heap is created.
      *
-     * @return Pointer to the new allocated memory.
+     * @return Pointer to the new allocated memory; nullptr, when no memory is left.
      */
     [[nodiscard]] void *allocate() noexcept
     {
-        if (empty())
+        auto *object = _chunk != nullptr ? _chunk->allocate() : nullptr;
+        if (object == nullptr)
         {
-            fill_buffer();
+            object = allocate_from_next_chunk();
         }
 
-        auto *free_element = std::exchange(_first, _first->next());
-        return static_cast<void *>(free_element);
+        return object;
     }
 
     /**
      * Frees a memory object. The new available memory location
-     * will be placed in front of the "available"-list. By this,
-     * the next allocation will use the just freed object, which
-     * may be still in the CPU cache.
+     * will be placed in front of the "available"-list of its chunk.
+     * By this, the next allocation will use the just freed object,
+     * which may be still in the CPU cache.
      *
      * @param pointer Pointer to the memory object to be freed.
      */
     void free(void *pointer) noexcept
     {
-        auto *free_object = static_cast<FreeHeader *>(pointer);
-        free_object->next(_first);
-        _first = free_object;
+        auto *chunk = Chunk::header(pointer);
+        const auto was_full = chunk->is_full();
+        chunk->free(pointer);
+
+        if (chunk != _chunk)
+        {
+            // Full chunks are not listed; now, the chunk has a free object again.
+            if (was_full)
+            {
+                push_available(chunk);
+            }
+
+            if (chunk->is_empty())
+            {
+                if (_count_empty_chunks < config::max_cached_free_chunks())
+                {
+                    ++_count_empty_chunks;
+                }
+                else
+                {
+                    remove_available(chunk);
+                    _processor_heap->free(Chunk{static_cast<void *>(chunk)});
+                }
+            }
+        }
     }
 
     /**
-     * Fills the buffer by asking the ProcessorHeap for more memory.
-     * This is latch-free since just a single core calls this method.
+     * Frees a memory object allocated by another core. The object
+     * is collected and returned to the home core once the batch
+     * for that core is full (or when flushed, see flush()).
+     *
+     * @param pointer Pointer to the memory object to be freed.
+     * @param home_core_heap CoreHeap the object was allocated from.
      */
-    void fill_buffer()
+    void free(void *pointer, CoreHeap<S> &home_core_heap) noexcept
     {
-        auto chunk = _processor_heap->allocate();
-        const auto chunk_address = static_cast<std::uintptr_t>(chunk);
-
-        constexpr auto object_size = S;
-        constexpr auto count_objects = std::uint64_t{Chunk::size() / object_size};
+        auto *free_object = static_cast<FreeHeader *>(pointer);
+        auto &batch =
+            _remote_batches[home_core_heap._core_id * config::max_numa_nodes() + home_core_heap._numa_node_id];
 
-        auto *first_free = reinterpret_cast<FreeHeader *>(chunk_address);
-        auto *last_free = reinterpret_cast<FreeHeader *>(chunk_address + ((count_objects - 1) * object_size));
+        free_object->next(batch.first);
+        batch.first = free_object;
+        if (batch.last == nullptr)
+        {
+            batch.last = free_object;
+            batch.home_core_heap = &home_core_heap;
+            ++_count_pending_batches;
+        }
 
-        auto *current_free = first_free;
-        for (auto i = 0U; i < count_objects - 1U; ++i)
+        if (++batch.count == config::remote_free_batch_size())
         {
-            auto *next = reinterpret_cast<FreeHeader *>(chunk_address + ((i + 1U) * object_size));
-            current_free->next(next);
-            current_free = next;
+            home_core_heap.give_back(batch.first, batch.last);
+            batch = RemoteBatch{};
+            --_count_pending_batches;
         }
+    }
 
-        last_free->next(nullptr);
-        _first = first_free;
+    /**
+     * Returns all objects of other cores, that are collected in
+     * batches not yet full, to their home cores. Otherwise, a few
+     * objects would stay at this core as long as it frees no more
+     * objects of the same home core.
+     */
+    void flush() noexcept
+    {
+        for (auto i = 0U; _count_pending_batches > 0U && i < _remote_batches.size(); ++i)
+        {
+            auto &batch = _remote_batches[i];
+            if (batch.count > 0U)
+            {
+                batch.home_core_heap->give_back(batch.first, batch.last);
+                batch = RemoteBatch{};
+                --_count_pending_batches;
+            }
+        }
     }
 
 private:
+    /**
+     * Objects freed by this core, that belong to another core.
+     */
+    struct RemoteBatch
+    {
+        FreeHeader *first{nullptr};
+        FreeHeader *last{nullptr};
+        CoreHeap<S> *home_core_heap{nullptr};
+        std::uint32_t count{0U};
+    };
+
     // Processor heap to allocate new chunks.
     ProcessorHeap *_processor_heap{nullptr};
 
-    // First element of the list of free memory objects.
-    FreeHeader *_first{nullptr};
+    // ID of the core owning this heap.
+    std::uint16_t _core_id{0U};
+
+    // ID of the NUMA region objects are allocated on.
+    std::uint8_t _numa_node_id{0U};
+
+    // Chunk objects are allocated from.
+    ChunkHeader *_chunk{nullptr};
+
+    // List of further chunks with free objects.
+    ChunkHeader *_available_chunks{nullptr};
+
+    // Number of listed chunks without any object in use.
+    std::uint32_t _count_empty_chunks{0U};
+
+    // Objects of other heaps, freed by this core; one batch per home core and NUMA region.
+    std::array<RemoteBatch, tasking::config::max_cores() * config::max_numa_nodes()> _remote_batches{};
+
+    // Number of batches holding at least one object.
+    std::uint32_t _count_pending_batches{0U};
+
+    // List of objects, returned by other cores.
+    alignas(64) std::atomic<FreeHeader *> _returned{nullptr};
+
+    /**
+     * Switches to the next chunk when the current one is full
+     * (or no chunk was allocated so far).
+     *
+     * @return Pointer to the new allocated memory; nullptr, when no memory is left.
+     */
+    [[nodiscard]] void *allocate_from_next_chunk() noexcept
+    {
+        // Objects returned by other cores go back to their chunks,
+        // which may be the current one.
+        auto *returned = _returned.exchange(nullptr, std::memory_order_acquire);
+        while (returned != nullptr)
+        {
+            free(static_cast<void *>(std::exchange(returned, returned->next())));
+        }
+
+        if (_chunk == nullptr || _chunk->is_full())
+        {
+            if (_available_chunks != nullptr)
+            {
+                _chunk = _available_chunks;
+                remove_available(_chunk);
+                if (_chunk->is_empty())
+                {
+                    --_count_empty_chunks;
+                }
+            }
+            else
+            {
+                auto *chunk = allocate_chunk();
+                if (chunk == nullptr)
+                {
+                    return nullptr;
+                }
+                _chunk = chunk;
+            }
+        }
+
+        return _chunk->allocate();
+    }
+
+    /**
+     * Allocates a chunk by asking the ProcessorHeap for more memory.
+     * This is latch-free since just a single core calls this method.
+     *
+     * @return Header of the new chunk; nullptr, when no memory is left.
+     */
+    ChunkHeader *allocate_chunk()
+    {
+        const auto chunk = _processor_heap->allocate();
+        if (static_cast<bool>(chunk) == false)
+        {
+            return nullptr;
+        }
+
+        // The first object holds the header of the chunk.
+        return new (static_cast<void *>(chunk)) ChunkHeader(_core_id, _numa_node_id, S, Chunk::size());
+    }
+
+    /**
+     * Adds a chunk to the list of chunks with free objects.
+     *
+     * @param chunk Chunk to add.
+     */
+    void push_available(ChunkHeader *chunk) noexcept
+    {
+        chunk->previous(nullptr);
+        chunk->next(_available_chunks);
+        if (_available_chunks != nullptr)
+        {
+            _available_chunks->previous(chunk);
+        }
+        _available_chunks = chunk;
+    }
+
+    /**
+     * Removes a chunk from the list of chunks with free objects.
+     *
+     * @param chunk Chunk to remove.
+     */
+    void remove_available(ChunkHeader *chunk) noexcept
+    {
+        if (chunk->previous() != nullptr)
+        {
+            chunk->previous()->next(chunk->next());
+        }
+        else
+        {
+            _available_chunks = chunk->next();
+        }
+
+        if (chunk->next() != nullptr)
+        {
+            chunk->next()->previous(chunk->previous());
+        }
+    }
 
     /**
-     * @return True, when the buffer is empty.
+     * Returns a list of objects, freed by another core, to this heap.
+     *
+     * @param first First object of the list.
+     * @param last Last object of the list.
      */
-    [[nodiscard]] bool empty() const noexcept { return _first == nullptr; }
+    void give_back(FreeHeader *first, FreeHeader *last) noexcept
+    {
+        auto *returned = _returned.load(std::memory_order_relaxed);
+        do
+        {
+            last->next(returned);
+        } while (_returned.compare_exchange_weak(returned, first, std::memory_order_release,
+                                                 std::memory_order_relaxed) == false);
+    }
 };
 
 /**
@@ -289,8 +754,14 @@ public:
 
         for (const auto core_id : core_set)
         {
-            const auto node_id = system::topology::node_id(core_id);
-            _core_heaps[core_id] = CoreHeap<S>{&_processor_heaps[node_id]};
+            _numa_node_ids[core_id] = system::topology::node_id(core_id);
+            for (auto &processor_heap : _processor_heaps)
+            {
+                if (processor_heap.numa_node_id() < config::max_numa_nodes())
+                {
+                    _core_heaps[core_id][processor_heap.numa_node_id()] = CoreHeap<S>{&processor_heap, core_id};
+                }
+            }
         }
     }
 
@@ -302,21 +773,122 @@ public:
      * @param core_id ID of the core.
      * @return Allocated memory object.
      */
-    [[nodiscard]] void *allocate(const std::uint16_t core_id) override { return _core_heaps[core_id].allocate(); }
+    [[nodiscard]] void *allocate(const std::uint16_t core_id) override
+    {
+        if constexpr (config::allocator_statistics())
+        {
+            _statistic.add<Statistic::AllocatedObjects>();
+            _statistic.add<Statistic::AllocatedBytes>(S);
+        }
+
+        return _core_heaps[core_id][_numa_node_ids[core_id]].allocate();
+    }
+
+    /**
+     * Allocates memory on the given NUMA region from the CoreHeap
+     * the given core holds for that region. Regions without cores
+     * of the runtime are replaced by the region of the core.
+     *
+     * @param core_id ID of the core.
+     * @param numa_node_id ID of the NUMA region.
+     * @return Allocated memory object.
+     */
+    [[nodiscard]] void *allocate(const std::uint16_t core_id, const std::uint8_t numa_node_id) override
+    {
+        if (numa_node_id < config::max_numa_nodes() && _processor_heaps[numa_node_id].numa_node_id() == numa_node_id)
+        {
+            if constexpr (config::allocator_statistics())
+            {
+                _statistic.add<Statistic::AllocatedObjects>();
+                _statistic.add<Statistic::AllocatedBytes>(S);
+                _statistic.add<Statistic::RemoteAllocations>(numa_node_id != _numa_node_ids[core_id]);
+            }
+
+            return _core_heaps[core_id][numa_node_id].allocate();
+        }
+
+        return allocate(core_id);
+    }
 
     /**
-     * Frees memory.
+     * Frees memory. Objects allocated by another core are
+     * returned to that core.
      *
-     * @param core_id ID of the core to place the free object in.
+     * @param core_id ID of the freeing core.
      * @param address Pointer to the memory object.
      */
-    void free(const std::uint16_t core_id, void *address) noexcept override { _core_heaps[core_id].free(address); }
+    void free(const std::uint16_t core_id, void *address) noexcept override
+    {
+        const auto *chunk = Chunk::header(address);
+        if constexpr (config::allocator_statistics())
+        {
+            _statistic.add<Statistic::FreedObjects>();
+            _statistic.add<Statistic::FreedBytes>(S);
+            _statistic.add<Statistic::RemoteFrees>(chunk->numa_node_id() != _numa_node_ids[core_id]);
+        }
+
+        auto &core_heap = _core_heaps[core_id][_numa_node_ids[core_id]];
+        if (chunk->core_id() == core_id && chunk->numa_node_id() == _numa_node_ids[core_id])
+        {
+            core_heap.free(address);
+        }
+        else
+        {
+            core_heap.free(address, _core_heaps[chunk->core_id()][chunk->numa_node_id()]);
+        }
+    }
+
+    /**
+     * Returns objects of other cores, freed by the given core, to their home cores.
+     *
+     * @param core_id ID of the freeing core.
+     */
+    void flush(const std::uint16_t core_id) noexcept override
+    {
+        _core_heaps[core_id][_numa_node_ids[core_id]].flush();
+    }
+
+    /**
+     * Releases the memory of chunks, that are not used any more.
+     */
+    void trim() noexcept override
+    {
+        for (auto &processor_heap : _processor_heaps)
+        {
+            if (processor_heap.numa_node_id() < config::max_numa_nodes())
+            {
+                processor_heap.trim();
+            }
+        }
+    }
+
+    [[nodiscard]] const Statistic &statistic() const noexcept override { return _statistic; }
+
+    /**
+     * @param numa_node_id NUMA region.
+     * @return State of the chunks held on the given NUMA region.
+     */
+    [[nodiscard]] NodeStatistic statistic(const std::uint8_t numa_node_id) const noexcept override
+    {
+        if (numa_node_id < config::max_numa_nodes())
+        {
+            return _processor_heaps[numa_node_id].statistic();
+        }
+
+        return NodeStatistic{};
+    }
 
 private:
     // Heap for every processor socket/NUMA region.
     std::array<ProcessorHeap, config::max_numa_nodes()> _processor_heaps;
 
-    // Map from core_id to core-local allocator.
-    std::array<CoreHeap<S>, tasking::config::max_cores()> _core_heaps;
+    // Map from core_id and NUMA region to core-local allocator.
+    std::array<std::array<CoreHeap<S>, config::max_numa_nodes()>, tasking::config::max_cores()> _core_heaps;
+
+    // Map from core_id to the NUMA region of the core.
+    std::array<std::uint8_t, tasking::config::max_cores()> _numa_node_ids{0U};
+
+    // Counters of allocated and freed tasks.
+    Statistic _statistic;
 };
 } // namespace mx::memory::fixed
\ No newline at end of file
@@ -1,8 +1,10 @@
 #pragma once
 #include "alignment_helper.h"
+#include "config.h"
 #include <cstdint>
 #include <cstdlib>
 #include <numa.h>
+#include <sys/mman.h>
 
 namespace mx::memory {
 /**
@@ -13,14 +15,143 @@ class GlobalHeap
 public:
     /**
      * Allocates the given size on the given NUMA node.
+     * Allocations of at least a huge page are backed by
+     * huge pages, if enabled (see config::huge_pages()).
      *
      * @param numa_node_id ID of the NUMA node, the memory should allocated on.
      * @param size  Size of the memory to be allocated.
-     * @return Pointer to allocated memory.
+     * @return Pointer to allocated memory; nullptr, when the memory could not be allocated.
      */
     static void *allocate(const std::uint8_t numa_node_id, const std::size_t size)
     {
-        return numa_alloc_onnode(size, numa_node_id);
+        if (GlobalHeap::is_huge(size) == false)
+        {
+            return numa_alloc_onnode(size, numa_node_id);
+        }
+
+        const auto huge_size = alignment_helper::next_multiple(size, config::huge_page_size());
+        if constexpr (config::huge_pages() == config::huge_page_scheme::Explicit)
+        {
+            constexpr auto page_size_flag = int(__builtin_ctzl(config::huge_page_size())) << MAP_HUGE_SHIFT;
+            auto *memory = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | page_size_flag, -1, 0);
+            if (memory != MAP_FAILED)
+            {
+                numa_tonode_memory(memory, huge_size, numa_node_id);
+                return memory;
+            }
+        }
+
+        // Transparent huge pages need aligned memory; when the kernel
+        // does not provide them, the memory is backed by regular pages.
+        auto *memory = GlobalHeap::allocate(numa_node_id, config::huge_page_size(), huge_size);
+        if (memory != nullptr)
+        {
+            madvise(memory, huge_size, MADV_HUGEPAGE);
+        }
+        return memory;
+    }
+
+    /**
+     * Allocates the given size; the pages are interleaved over all NUMA nodes.
+     *
+     * @param size  Size of the memory to be allocated.
+     * @return Pointer to allocated memory; nullptr, when the memory could not be allocated.
+     */
+    static void *allocate_interleaved(const std::size_t size)
+    {
+        if (GlobalHeap::is_huge(size) == false)
+        {
+            return numa_alloc_interleaved(size);
+        }
+
+        // Interleaving is page-granular; with huge pages enabled, it interleaves huge pages.
+        const auto huge_size = alignment_helper::next_multiple(size, config::huge_page_size());
+        auto *memory = numa_alloc_interleaved(huge_size);
+        if (memory != nullptr)
+        {
+            madvise(memory, huge_size, MADV_HUGEPAGE);
+        }
+        return memory;
+    }
+
+    /**
+     * Allocates the given size on the given NUMA node, aligned to
+     * the given alignment (a multiple of the page size). The memory
+     * is over-allocated and the unaligned surplus is released.
+     *
+     * @param numa_node_id ID of the NUMA node, the memory should allocated on.
+     * @param alignment Alignment of the memory.
+     * @param size Size of the memory to be allocated.
+     * @return Pointer to allocated memory; nullptr, when the memory could not be allocated.
+     */
+    static void *allocate(const std::uint8_t numa_node_id, const std::size_t alignment, const std::size_t size)
+    {
+        auto *memory = numa_alloc_onnode(size + alignment, numa_node_id);
+        if (memory == nullptr)
+        {
+            return nullptr;
+        }
+
+        const auto address = reinterpret_cast<std::uintptr_t>(memory);
+        const auto aligned_address = alignment_helper::next_multiple(address, std::uintptr_t(alignment));
+
+        if (aligned_address > address)
+        {
+            numa_free(memory, aligned_address - address);
+        }
+
+        const auto surplus_size = (address + size + alignment) - (aligned_address + size);
+        if (surplus_size > 0U)
+        {
+            numa_free(reinterpret_cast<void *>(aligned_address + size), surplus_size);
+        }
+
+        return reinterpret_cast<void *>(aligned_address);
+    }
+
+    /**
+     * Reserves the given size of virtual memory, aligned to the given
+     * alignment (a multiple of the page size). Physical memory is not
+     * committed until the memory is touched; pages are placed on the NUMA
+     * node of the core touching them first. Transparent huge pages
+     * are advised, if huge pages are enabled (see config::huge_pages()).
+     *
+     * @param alignment Alignment of the memory.
+     * @param size Size of the memory to be reserved.
+     * @return Pointer to reserved memory; nullptr, when the address space is exhausted.
+     */
+    static void *reserve(const std::size_t alignment, const std::size_t size)
+    {
+        auto *memory = mmap(nullptr, size + alignment, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (memory == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        const auto address = reinterpret_cast<std::uintptr_t>(memory);
+        const auto aligned_address = alignment_helper::next_multiple(address, std::uintptr_t(alignment));
+
+        if (aligned_address > address)
+        {
+            munmap(memory, aligned_address - address);
+        }
+
+        const auto surplus_size = (address + size + alignment) - (aligned_address + size);
+        if (surplus_size > 0U)
+        {
+            munmap(reinterpret_cast<void *>(aligned_address + size), surplus_size);
+        }
+
+        // Explicit huge pages are not used: touching reserved but
+        // uncommitted hugetlb pages crashes when the pool is empty.
+        if constexpr (config::huge_pages() != config::huge_page_scheme::None)
+        {
+            madvise(reinterpret_cast<void *>(aligned_address), size, MADV_HUGEPAGE);
+        }
+
+        return reinterpret_cast<void *>(aligned_address);
     }
 
     /**
@@ -41,6 +172,29 @@ public:
      * @param memory Pointer to memory.
      * @param size Size of the allocated object.
      */
-    static void free(void *memory, const std::size_t size) { numa_free(memory, size); }
+    static void free(void *memory, const std::size_t size)
+    {
+        numa_free(memory, GlobalHeap::is_huge(size) ? alignment_helper::next_multiple(size, config::huge_page_size())
+                                                    : size);
+    }
+
+    /**
+     * Releases the physical memory of the given memory to the operating
+     * system. The memory stays allocated and will be zeroed on next access.
+     *
+     * @param memory Pointer to memory.
+     * @param size Size of the memory.
+     */
+    static void release(void *memory, const std::size_t size) { madvise(memory, size, MADV_DONTNEED); }
+
+private:
+    /**
+     * @param size Size of an allocation.
+     * @return True, when the allocation is backed by huge pages.
+     */
+    [[nodiscard]] static constexpr bool is_huge(const std::size_t size) noexcept
+    {
+        return config::huge_pages() != config::huge_page_scheme::None && size >= config::huge_page_size();
+    }
 };
 } // namespace mx::memory
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "persistent_heap.h"
+#include "alignment_helper.h"
+#include "config.h"
+#include <algorithm>
+#include <fcntl.h>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+using namespace mx::memory::dynamic;
+
+PersistentHeap::PersistentHeap(const std::string &path, const std::size_t size, const std::uint8_t marker)
+    : _size(alignment_helper::next_multiple(size, HEADER_SIZE))
+{
+    this->_file_descriptor = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (this->_file_descriptor < 0)
+    {
+        return;
+    }
+
+    struct stat file_status
+    {
+    };
+    const auto is_existing =
+        fstat(this->_file_descriptor, &file_status) == 0 && std::size_t(file_status.st_size) == this->_size;
+    if (is_existing == false && ftruncate(this->_file_descriptor, off_t(this->_size)) != 0)
+    {
+        ::close(std::exchange(this->_file_descriptor, -1));
+        return;
+    }
+
+    // Kernels not knowing MAP_FIXED_NOREPLACE take the address as a hint.
+    auto *address = reinterpret_cast<void *>(config::persistent_heap_address());
+    auto *memory =
+        mmap(address, this->_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED_NOREPLACE, this->_file_descriptor, 0);
+    if (memory != address)
+    {
+        if (memory != MAP_FAILED)
+        {
+            munmap(memory, this->_size);
+        }
+        ::close(std::exchange(this->_file_descriptor, -1));
+        return;
+    }
+
+    this->_header = static_cast<Header *>(memory);
+    this->_is_restored = is_existing && this->_header->magic == MAGIC &&
+                         this->_header->address == config::persistent_heap_address() &&
+                         this->_header->size == this->_size && this->_header->is_closed;
+
+    const auto heap_address = config::persistent_heap_address() + HEADER_SIZE;
+    const auto heap_size = this->_size - HEADER_SIZE;
+
+    auto free_elements = std::vector<FreeHeader>{};
+    if (this->_is_restored)
+    {
+        free_elements.assign(this->_header->free_elements,
+                             this->_header->free_elements + this->_header->count_free_elements);
+    }
+    else
+    {
+        this->_header->magic = MAGIC;
+        this->_header->address = config::persistent_heap_address();
+        this->_header->size = this->_size;
+        this->_header->root = nullptr;
+        free_elements.emplace_back(FreeHeader{heap_address, heap_size});
+    }
+
+    this->_block = std::make_unique<AllocationBlock>(0U, marker, reinterpret_cast<void *>(heap_address), heap_size,
+                                                     std::move(free_elements));
+
+    if (this->_is_restored)
+    {
+        this->_block->free(reinterpret_cast<AllocatedHeader *>(
+            reinterpret_cast<std::uintptr_t>(this->_header->free_elements) - sizeof(AllocatedHeader)));
+    }
+
+    // Until closed, the heap is not restored after a restart.
+    this->_header->free_elements = nullptr;
+    this->_header->count_free_elements = 0U;
+    this->_header->is_closed = false;
+    msync(this->_header, HEADER_SIZE, MS_SYNC);
+}
+
+PersistentHeap::~PersistentHeap()
+{
+    if (this->_header == nullptr)
+    {
+        return;
+    }
+
+    // The table of free regions is allocated on the heap itself, which may
+    // remove free regions but never adds one. When the heap is exhausted,
+    // the table can not be written and the heap is not restored.
+    const auto count_free_elements = std::max<std::size_t>(this->_block->free_elements().size(), 1U);
+    auto *table = static_cast<FreeHeader *>(this->_block->allocate(64U, sizeof(FreeHeader) * count_free_elements));
+    if (table != nullptr)
+    {
+        const auto free_elements = this->_block->free_elements();
+        std::uninitialized_copy(free_elements.begin(), free_elements.end(), table);
+        this->_header->free_elements = table;
+        this->_header->count_free_elements = free_elements.size();
+        this->_header->is_closed = true;
+    }
+
+    this->_block.reset();
+    msync(this->_header, this->_size, MS_SYNC);
+    munmap(this->_header, this->_size);
+    ::close(this->_file_descriptor);
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "dynamic_size_allocator.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace mx::memory::dynamic {
+/**
+ * Heap backed by a memory-mapped file, which outlives the process. The
+ * file is always mapped to the same address (see config::persistent_heap_address()),
+ * thus, pointers between objects on the heap stay valid after a restart.
+ * The memory is managed by a single allocation block, whose free regions are
+ * written to the file when the heap is closed. A heap that was not closed
+ * (e.g., after a crash) is not restored, but created empty.
+ *
+ * Objects on the heap must not point to memory outside the heap. Pointers to
+ * virtual tables are stale after a restart; resources rebuild them when they
+ * are restored (see resource::restore_t).
+ */
+class PersistentHeap
+{
+public:
+    /**
+     * Maps (and restores) the heap of the given file; the file is created, if it does not exist.
+     *
+     * @param path File of the heap.
+     * @param size Size of the heap; an existing file of another size is not restored.
+     * @param marker Marker written to the header of allocated memory, instead of the NUMA node.
+     */
+    PersistentHeap(const std::string &path, std::size_t size, std::uint8_t marker);
+
+    /**
+     * Writes the free regions to the file and unmaps the heap.
+     */
+    ~PersistentHeap();
+
+    /**
+     * @return True, if the file is mapped.
+     */
+    [[nodiscard]] bool is_open() const noexcept { return _header != nullptr; }
+
+    /**
+     * @return True, if the heap of a previous run was restored.
+     */
+    [[nodiscard]] bool is_restored() const noexcept { return _is_restored; }
+
+    /**
+     * Allocates memory from the heap.
+     *
+     * @param alignment Requested alignment.
+     * @param size Requested size.
+     * @return Pointer to the allocated memory; nullptr, when the heap is exhausted.
+     */
+    [[nodiscard]] void *allocate(const std::size_t alignment, const std::size_t size) noexcept
+    {
+        return _block->allocate(alignment, size);
+    }
+
+    /**
+     * Allocates a set of objects from one contiguous region of the heap.
+     *
+     * @param alignment Requested alignment of every object.
+     * @param size Requested size of every object.
+     * @param count Number of objects.
+     * @param objects Array receiving the pointers to the allocated objects.
+     * @return True, if all objects were allocated; false, if the heap is exhausted.
+     */
+    bool allocate(const std::size_t alignment, const std::size_t size, const std::size_t count,
+                  void **objects) noexcept
+    {
+        return _block->allocate(alignment, size, count, objects);
+    }
+
+    /**
+     * Frees memory.
+     *
+     * @param allocation_header Pointer to the header of the freed memory.
+     */
+    void free(AllocatedHeader *allocation_header) noexcept { _block->free(allocation_header); }
+
+    /**
+     * @return Object the application stored as entry point, e.g., the root of a data structure.
+     */
+    [[nodiscard]] void *root() const noexcept { return _header->root; }
+
+    /**
+     * Stores the entry point of the application, which is restored with the heap.
+     *
+     * @param root Object on the heap.
+     */
+    void root(void *root) noexcept { _header->root = root; }
+
+private:
+    // Identifies files holding a heap ("MXHEAP" and the version of the layout).
+    inline static constexpr auto MAGIC = std::uint64_t(0x4d58484541500001ULL);
+
+    // The header occupies the first page of the file.
+    inline static constexpr auto HEADER_SIZE = std::size_t(4096U);
+
+    /**
+     * Header at the start of the file.
+     */
+    struct Header
+    {
+        std::uint64_t magic;
+        std::uintptr_t address;
+        std::size_t size;
+
+        // True, if the free regions were written on close.
+        bool is_closed;
+
+        void *root;
+
+        // Table of free regions, allocated on the heap itself.
+        FreeHeader *free_elements;
+        std::uint64_t count_free_elements;
+    };
+
+    // File descriptor of the mapped file.
+    int _file_descriptor{-1};
+
+    // Size of the mapping, including the header.
+    std::size_t _size;
+
+    // Header of the mapped file; nullptr, if the file could not be mapped.
+    Header *_header{nullptr};
+
+    // Allocation block managing the memory behind the header.
+    std::unique_ptr<AllocationBlock> _block{nullptr};
+
+    bool _is_restored{false};
+};
+} // namespace mx::memory::dynamic
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "epoch_manager.h"
+#include <cassert>
+#include <cstdint>
+
+namespace mx::memory::reclamation {
+/**
+ * Takes part in epochs from a thread besides the workers, e.g., a client
+ * thread serving reads without spawning a task, or a monitoring thread
+ * walking a data structure. The thread is registered as long as the
+ * participant lives; before reading optimistic resources, it enters the
+ * epoch by an EpochGuard, which keeps the read resources from being reclaimed.
+ * A participant must only be used by the thread that created it.
+ */
+class EpochParticipant
+{
+    friend class EpochGuard;
+
+public:
+    explicit EpochParticipant(EpochManager &epoch_manager) noexcept
+        : _epoch_manager(epoch_manager), _local_epoch(epoch_manager.register_external())
+    {
+    }
+
+    EpochParticipant(const EpochParticipant &) = delete;
+    EpochParticipant(EpochParticipant &&) = delete;
+
+    ~EpochParticipant() noexcept
+    {
+        if (_local_epoch != nullptr)
+        {
+            _epoch_manager.unregister_external(_local_epoch);
+        }
+    }
+
+    /**
+     * @return True, if the thread is registered; false, if too many threads take part.
+     */
+    [[nodiscard]] bool is_registered() const noexcept { return _local_epoch != nullptr; }
+
+private:
+    EpochManager &_epoch_manager;
+
+    // Epoch of the thread; nullptr, if not registered.
+    LocalEpoch *_local_epoch;
+
+    // Number of guards currently holding the epoch; only the outermost enters and leaves.
+    std::uint32_t _depth{0U};
+};
+
+/**
+ * Holds the epoch of a participant while in scope. Entering the epoch
+ * is a single (fenced) store; guards may be nested.
+ */
+class EpochGuard
+{
+public:
+    explicit EpochGuard(EpochParticipant &participant) noexcept : _participant(participant)
+    {
+        assert(participant.is_registered() && "Participant is not registered.");
+
+        if (_participant._depth++ == 0U)
+        {
+            _participant._local_epoch->enter(_participant._epoch_manager.global_epoch());
+        }
+    }
+
+    EpochGuard(const EpochGuard &) = delete;
+    EpochGuard(EpochGuard &&) = delete;
+
+    ~EpochGuard() noexcept
+    {
+        if (--_participant._depth == 0U)
+        {
+            _participant._local_epoch->leave();
+        }
+    }
+
+private:
+    EpochParticipant &_participant;
+};
+} // namespace mx::memory::reclamation
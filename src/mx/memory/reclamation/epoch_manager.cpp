@@ -1,11 +1,37 @@
 #include "epoch_manager.h"
-#include <mx/system/topology.h>
+#include <algorithm>
+#include <cstdlib>
+#include <mx/memory/global_heap.h>
 #include <mx/tasking/runtime.h>
-#include <mx/util/queue.h>
 #include <thread>
 
 using namespace mx::memory::reclamation;
 
+EpochManager::EpochManager(const std::uint16_t count_channels, dynamic::Allocator &allocator,
+                           util::maybe_atomic<bool> &is_running) noexcept
+    : _count_channels(count_channels), _is_running(is_running), _allocator(allocator)
+{
+    for (auto channel_id = 0U; channel_id < count_channels; ++channel_id)
+    {
+        auto *reclaim_task = new (GlobalHeap::allocate_cache_line_aligned(sizeof(ReclaimEpochGarbageTask)))
+            ReclaimEpochGarbageTask(*this);
+        reclaim_task->annotate(std::uint16_t(channel_id));
+        this->_reclaim_tasks[channel_id] = reclaim_task;
+    }
+}
+
+EpochManager::~EpochManager() noexcept
+{
+    for (auto *reclaim_task : this->_reclaim_tasks)
+    {
+        if (reclaim_task != nullptr)
+        {
+            reclaim_task->~ReclaimEpochGarbageTask();
+            std::free(reclaim_task);
+        }
+    }
+}
+
 void EpochManager::enter_epoch_periodically()
 {
     // Wait until the scheduler starts the system.
@@ -14,94 +40,189 @@ void EpochManager::enter_epoch_periodically()
         system::builtin::pause();
     }
 
+    auto epoch_interval = std::chrono::duration_cast<std::chrono::microseconds>(config::epoch_interval());
+    auto time_since_trim = std::chrono::microseconds{0U};
+
     // Enter new epochs and collect garbage periodically
     // while the system is running.
     while (this->_is_running)
     {
-        // Enter new epoch.
-        this->_global_epoch.fetch_add(1U);
+        // Collect garbage of finished epochs.
+        const auto count_removed_resources = this->reclaim_epoch_garbage();
 
-        if constexpr (config::local_garbage_collection())
-        {
-            // Collect local garbage.
-            const auto core_id = mx::system::topology::core_id();
-            for (auto channel_id = 0U; channel_id < this->_count_channels; ++channel_id)
-            {
-                auto *garbage_task =
-                    mx::tasking::runtime::new_task<ReclaimEpochGarbageTask>(core_id, *this, this->_allocator);
-                garbage_task->annotate(std::uint16_t(channel_id));
-                mx::tasking::runtime::spawn(*garbage_task);
-            }
-        }
-        else
+        this->enter_next_epoch();
+        epoch_interval = EpochManager::adapt_epoch_interval(epoch_interval, count_removed_resources);
+
+        // Release memory of unused task chunks.
+        time_since_trim += epoch_interval;
+        if (time_since_trim >= config::epoch_interval())
         {
-            // Collect global garbage of finished epochs.
-            this->reclaim_epoch_garbage();
+            mx::tasking::runtime::trim_task_memory();
+            time_since_trim = std::chrono::microseconds{0U};
         }
 
         // Wait some time until next epoch.
-        std::this_thread::sleep_for(config::epoch_interval()); // NOLINT: sleep_for seems to crash clang-tidy
+        std::this_thread::sleep_for(epoch_interval); // NOLINT: sleep_for seems to crash clang-tidy
     }
 }
 
-void EpochManager::reclaim_epoch_garbage() noexcept
+bool EpochManager::enter_next_epoch() noexcept
 {
-    // Items logically removed in an epoch leq than
-    // this epoch can be removed physically.
-    const auto min_epoch = this->min_local_epoch();
+    const auto epoch = this->_global_epoch.load();
+    const auto min_epoch = std::min(this->min_local_epoch(), epoch);
+    if (epoch - min_epoch <= config::limbo_buckets() - 2U)
+    {
+        this->_global_epoch.fetch_add(1U);
+        return true;
+    }
 
-    // Items that could not be physically removed in this epoch
-    // and therefore have to be scheduled to the next one.
-    util::Queue<resource::ResourceInterface> deferred_resources{};
+    return false;
+}
 
-    resource::ResourceInterface *resource;
-    while ((resource = reinterpret_cast<resource::ResourceInterface *>(this->_global_garbage_queue.pop_front())) !=
-           nullptr)
+std::chrono::microseconds EpochManager::adapt_epoch_interval(const std::chrono::microseconds epoch_interval,
+                                                             const std::uint64_t count_removed_resources) noexcept
+{
+    if (count_removed_resources > config::epoch_garbage_threshold())
     {
-        if (resource->remove_epoch() < min_epoch)
-        {
-            resource->on_reclaim();
-            this->_allocator.free(static_cast<void *>(resource));
-        }
-        else
+        return std::max<std::chrono::microseconds>(epoch_interval / 2U, config::min_epoch_interval());
+    }
+
+    return std::min<std::chrono::microseconds>(epoch_interval * 2U, config::epoch_interval());
+}
+
+std::uint64_t EpochManager::reclaim_epoch_garbage() noexcept
+{
+    const auto epoch = this->_global_epoch.load();
+
+    // Channels that got garbage since the last call need to release it later.
+    auto count_removed_resources = std::uint64_t{0U};
+    for (auto channel_id = 0U; channel_id < this->_count_channels; ++channel_id)
+    {
+        auto &limbo_list = this->_limbo_lists[channel_id];
+        if (const auto count = limbo_list.collect_count_added_resources(); count > 0U)
         {
-            deferred_resources.push_back(resource);
+            count_removed_resources += count;
+            limbo_list.last_garbage_epoch(epoch);
         }
     }
 
-    // Resources that could not be deleted physically
-    // need to be deleted in next epochs.
-    if (deferred_resources.empty() == false)
+    // Items logically removed in an epoch less than
+    // this epoch can be removed physically.
+    const auto reclaimable_epoch = std::min(this->min_local_epoch(), epoch);
+    for (auto channel_id = 0U; channel_id < this->_count_channels; ++channel_id)
     {
-        this->_global_garbage_queue.push_back(deferred_resources.begin(), deferred_resources.end());
+        // Tasks still waiting for execution are spawned again on a later call.
+        auto *reclaim_task = this->_reclaim_tasks[channel_id];
+        if (reclaim_task->is_spawned() || reclaim_task->reclaimed_epoch() >= reclaimable_epoch)
+        {
+            continue;
+        }
+
+        // Only channels that may hold garbage of the reclaimable epochs release their buckets.
+        const auto last_garbage_epoch = this->_limbo_lists[channel_id].last_garbage_epoch();
+        if (last_garbage_epoch != std::numeric_limits<epoch_t>::max() &&
+            last_garbage_epoch >= reclaim_task->reclaimed_epoch())
+        {
+            reclaim_task->reclaim_until(reclaimable_epoch);
+            mx::tasking::runtime::spawn(*reclaim_task);
+        }
     }
+
+    return count_removed_resources;
 }
 
-void EpochManager::reclaim_all() noexcept
+void EpochManager::reclaim(const std::uint16_t channel_id, const epoch_t from_epoch, const epoch_t to_epoch) noexcept
 {
-    if constexpr (config::local_garbage_collection())
+    // Whole buckets are scanned. A bucket is shared by every limbo_buckets()-th
+    // epoch; when the global epoch wrapped around before this channel released
+    // the bucket, resources removed in an epoch not before to_epoch are kept.
+    auto &limbo_list = this->_limbo_lists[channel_id];
+    const auto count_epochs = std::min<epoch_t>(to_epoch - from_epoch, config::limbo_buckets());
+    for (auto epoch = from_epoch; epoch < from_epoch + count_epochs; ++epoch)
     {
-        for (auto channel_id = 0U; channel_id < this->_count_channels; ++channel_id)
+        auto &bucket = limbo_list.bucket(epoch);
+
+        resource::ResourceInterface *first_kept = nullptr;
+        resource::ResourceInterface *last_kept = nullptr;
+        resource::ResourceInterface *resource;
+        while ((resource = reinterpret_cast<resource::ResourceInterface *>(bucket.pop_front())) != nullptr)
         {
-            resource::ResourceInterface *resource;
-            while ((resource = reinterpret_cast<resource::ResourceInterface *>(
-                        this->_local_garbage_queues[channel_id].value().pop_front())) != nullptr)
+            if (resource->remove_epoch() >= to_epoch)
+            {
+                if (last_kept == nullptr)
+                {
+                    first_kept = resource;
+                }
+                else
+                {
+                    last_kept->next(resource);
+                }
+                last_kept = resource;
+                continue;
+            }
+
+            // Every replica of a replicated resource was constructed and has to be destroyed.
+            if (const auto *replica_table = this->_allocator.replicas(static_cast<void *>(resource));
+                replica_table != nullptr)
+            {
+                for (auto *replica : replica_table->replicas)
+                {
+                    if (replica != nullptr)
+                    {
+                        static_cast<resource::ResourceInterface *>(replica)->on_reclaim();
+                    }
+                }
+            }
+            else
             {
                 resource->on_reclaim();
-                this->_allocator.free(static_cast<void *>(resource));
             }
+            this->_allocator.free(static_cast<void *>(resource));
+        }
+
+        if (first_kept != nullptr)
+        {
+            bucket.push_back(first_kept, last_kept);
         }
     }
-    else
+}
+
+void EpochManager::reclaim_all() noexcept
+{
+    for (auto channel_id = 0U; channel_id < this->_count_channels; ++channel_id)
     {
-        resource::ResourceInterface *resource;
-        while ((resource = reinterpret_cast<resource::ResourceInterface *>(this->_global_garbage_queue.pop_front())) !=
-               nullptr)
+        this->reclaim(std::uint16_t(channel_id), 0U, std::numeric_limits<epoch_t>::max());
+        static_cast<void>(this->_limbo_lists[channel_id].collect_count_added_resources());
+        this->_limbo_lists[channel_id].last_garbage_epoch(std::numeric_limits<epoch_t>::max());
+    }
+}
+
+LocalEpoch *EpochManager::register_external() noexcept
+{
+    for (auto i = 0U; i < config::max_external_epoch_participants(); ++i)
+    {
+        auto is_used = false;
+        if (this->_is_external_epoch_used[i].compare_exchange_strong(is_used, true))
         {
-            resource->on_reclaim();
-            this->_allocator.free(static_cast<void *>(resource));
+            // Slots are scanned by min_local_epoch() up to the highest slot ever used.
+            auto count_external_epochs = this->_count_external_epochs.load();
+            while (count_external_epochs <= i &&
+                   this->_count_external_epochs.compare_exchange_weak(count_external_epochs, std::uint16_t(i + 1U)) ==
+                       false)
+            {
+            }
+
+            return &this->_external_epochs[i];
         }
     }
+
+    return nullptr;
+}
+
+void EpochManager::unregister_external(LocalEpoch *local_epoch) noexcept
+{
+    local_epoch->leave();
+    this->_is_external_epoch_used[std::distance(this->_external_epochs.data(), local_epoch)].store(false);
 }
 
 void EpochManager::reset() noexcept
@@ -113,43 +234,21 @@ void EpochManager::reset() noexcept
         {
             _local_epochs[channel_id] = std::numeric_limits<epoch_t>::max();
         }
+
+        for (auto channel_id = 0U; channel_id < this->_count_channels; ++channel_id)
+        {
+            this->_reclaim_tasks[channel_id]->reset();
+        }
     }
 }
 
 mx::tasking::TaskResult ReclaimEpochGarbageTask::execute(const std::uint16_t /*core_id*/,
                                                          const std::uint16_t channel_id)
 {
-    // Items logically removed in an epoch leq than
-    // this epoch can be removed physically.
-    const auto min_epoch = this->_epoch_manager.min_local_epoch();
-
-    // Items that could not be physically removed in this epoch
-    // and therefore have to be scheduled to the next one.
-    util::Queue<resource::ResourceInterface> deferred_resources{};
-
-    // Queue with channel-local garbage.
-    auto &garbage_queue = this->_epoch_manager.local_garbage(channel_id);
-
-    resource::ResourceInterface *resource;
-    while ((resource = reinterpret_cast<resource::ResourceInterface *>(garbage_queue.pop_front())) != nullptr)
-    {
-        if (resource->remove_epoch() < min_epoch)
-        {
-            resource->on_reclaim();
-            this->_allocator.free(static_cast<void *>(resource));
-        }
-        else
-        {
-            deferred_resources.push_back(resource);
-        }
-    }
-
-    // Resources that could not be deleted physically
-    // need to be deleted in next epochs.
-    if (deferred_resources.empty() == false)
-    {
-        garbage_queue.push_back(deferred_resources.begin(), deferred_resources.end());
-    }
+    this->_epoch_manager.reclaim(channel_id, this->_reclaimed_epoch, this->_to_epoch);
+    this->_reclaimed_epoch = std::max(this->_reclaimed_epoch, this->_to_epoch);
 
-    return tasking::TaskResult::make_remove();
+    // The task is owned by the epoch manager and spawned again later.
+    this->_is_spawned.store(false, std::memory_order_release);
+    return tasking::TaskResult::make_null();
 }
@@ -5,6 +5,7 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <limits>
 #include <mx/memory/config.h>
 #include <mx/memory/dynamic_size_allocator.h>
 #include <mx/resource/resource_interface.h>
@@ -36,37 +37,121 @@ public:
     }
     void leave() noexcept { _epoch.store(std::numeric_limits<epoch_t>::max()); }
 
+    /**
+     * Announces a quiescent state, where the worker holds no reference to
+     * any resource (e.g., between two tasks). Without fences, the global
+     * epoch may be read stale, which only delays reclamation. The local
+     * epoch is only written when the global epoch moved on.
+     *
+     * @param global_epoch Global epoch.
+     */
+    void quiescent(const std::atomic<epoch_t> &global_epoch) noexcept
+    {
+        const auto epoch = global_epoch.load(std::memory_order_relaxed);
+        if (epoch != _epoch.load(std::memory_order_relaxed))
+        {
+            _epoch.store(epoch, std::memory_order_release);
+        }
+    }
+
     [[nodiscard]] epoch_t operator()() const noexcept { return _epoch.load(std::memory_order_seq_cst); }
 
 private:
     std::atomic<epoch_t> _epoch{std::numeric_limits<epoch_t>::max()};
 };
 
+/**
+ * Garbage of a single channel, bucketed by the epoch the resources were
+ * removed in. Resources are added by every channel, but only released
+ * by the owning channel, bucket by bucket when the epoch aged out.
+ */
+class alignas(64) LimboList
+{
+public:
+    constexpr LimboList() noexcept = default;
+    ~LimboList() noexcept = default;
+
+    /**
+     * Adds a removed resource to the bucket of the given epoch.
+     * @param resource Removed resource.
+     * @param epoch Epoch the resource was removed in.
+     */
+    void push_back(resource::ResourceInterface *resource, const epoch_t epoch) noexcept
+    {
+        _buckets[epoch % config::limbo_buckets()].push_back(resource);
+        _count_added_resources.fetch_add(1U, std::memory_order_relaxed);
+    }
+
+    /**
+     * @param epoch Epoch.
+     * @return Bucket of the resources removed in the given epoch.
+     */
+    [[nodiscard]] util::MPSCQueue<resource::ResourceInterface> &bucket(const epoch_t epoch) noexcept
+    {
+        return _buckets[epoch % config::limbo_buckets()];
+    }
+
+    /**
+     * @return Number of resources added since the last call.
+     */
+    [[nodiscard]] std::uint64_t collect_count_added_resources() noexcept
+    {
+        return _count_added_resources.exchange(0U, std::memory_order_relaxed);
+    }
+
+    /**
+     * @return Last epoch resources were added in; only accessed by the epoch manager.
+     */
+    [[nodiscard]] epoch_t last_garbage_epoch() const noexcept { return _last_garbage_epoch; }
+
+    /**
+     * Remembers the last epoch resources were added in; only accessed by the epoch manager.
+     * @param epoch Epoch.
+     */
+    void last_garbage_epoch(const epoch_t epoch) noexcept { _last_garbage_epoch = epoch; }
+
+private:
+    // Resources added since the epoch manager looked last.
+    std::atomic_uint64_t _count_added_resources{0U};
+
+    // Epoch the epoch manager saw the last resources added in.
+    epoch_t _last_garbage_epoch{std::numeric_limits<epoch_t>::max()};
+
+    // One queue of removed resources per epoch in flight.
+    std::array<util::MPSCQueue<resource::ResourceInterface>, config::limbo_buckets()> _buckets;
+};
+
+class ReclaimEpochGarbageTask;
+
 /**
  * The Epoch Manager manages periodic epochs which
  * are used to protect reads against concurrent
  * delete operations. Therefore, a global epoch
- * will be incremented every 50ms (configurable).
+ * will be incremented periodically; the interval
+ * adapts to the amount of removed resources.
  * Read operations, on the other hand, will update
  * their local epoch every time before reading an
  * optimistic resource.
+ * With quiescent-state-based reclamation, workers
+ * instead announce the global epoch between two
+ * tasks, where no resource is referenced; a grace
+ * period has passed when all workers announced an
+ * epoch newer than the removal.
  * When (logically) deleting an optimistic resource,
- * the resource will be deleted physically, when
- * every local epoch is greater than the epoch
- * when the resource is deleted.
+ * the resource is added to the limbo list of its
+ * channel. It will be deleted physically by that
+ * channel, when every local epoch is greater than
+ * the epoch when the resource is deleted.
  */
 class EpochManager
 {
 public:
-    EpochManager(const std::uint16_t count_channels, dynamic::Allocator &allocator,
-                 util::maybe_atomic<bool> &is_running) noexcept
-        : _count_channels(count_channels), _is_running(is_running), _allocator(allocator)
-    {
-    }
+    EpochManager(std::uint16_t count_channels, dynamic::Allocator &allocator,
+                 util::maybe_atomic<bool> &is_running) noexcept;
 
     EpochManager(const EpochManager &) = delete;
 
-    ~EpochManager() = default;
+    ~EpochManager() noexcept;
 
     LocalEpoch &operator[](const std::uint16_t channel_id) noexcept { return _local_epochs[channel_id]; }
 
@@ -86,26 +171,42 @@ public:
             min_epoch = std::min(min_epoch, _local_epochs[channel_id]());
         }
 
+        // Unused epochs of external participants are left.
+        const auto count_external_epochs = _count_external_epochs.load(std::memory_order_acquire);
+        for (auto i = 0U; i < count_external_epochs; ++i)
+        {
+            min_epoch = std::min(min_epoch, _external_epochs[i]());
+        }
+
         return min_epoch;
     }
 
+    /**
+     * Registers a thread besides the workers (e.g., a client or monitoring
+     * thread), that reads optimistic resources. The thread has to enter the
+     * returned epoch while reading (see EpochGuard).
+     *
+     * @return Local epoch of the thread; nullptr, when too many threads are registered.
+     */
+    [[nodiscard]] LocalEpoch *register_external() noexcept;
+
+    /**
+     * Unregisters a thread registered by register_external().
+     * @param local_epoch Local epoch of the thread.
+     */
+    void unregister_external(LocalEpoch *local_epoch) noexcept;
+
     /**
      * Adds an optimistic resource to garbage collection.
      * @param resource Resource to logically delete.
+     * @param owning_channel_id Channel the resource is scheduled to, which will release it.
      */
     void add_to_garbage_collection(resource::ResourceInterface *resource,
-                                   [[maybe_unused]] const std::uint16_t owning_channel_id) noexcept
+                                   const std::uint16_t owning_channel_id) noexcept
     {
-        resource->remove_epoch(_global_epoch.load(std::memory_order_acq_rel));
-
-        if constexpr (config::local_garbage_collection())
-        {
-            _local_garbage_queues[owning_channel_id].value().push_back(resource);
-        }
-        else
-        {
-            _global_garbage_queue.push_back(resource);
-        }
+        const auto epoch = _global_epoch.load(std::memory_order_seq_cst);
+        resource->remove_epoch(epoch);
+        _limbo_lists[owning_channel_id].push_back(resource, epoch);
     }
 
     /**
@@ -114,20 +215,39 @@ public:
     void enter_epoch_periodically();
 
     /**
-     * Reclaims all garbage, mainly right before shut down tasking.
+     * Enters the next global epoch, unless the garbage of the oldest epoch
+     * still in use would share the bucket of the limbo lists with the new epoch.
+     *
+     * @return True, when the next epoch was entered.
      */
-    void reclaim_all() noexcept;
+    bool enter_next_epoch() noexcept;
 
     /**
-     * Grants access to the local garbage queue of a specific channel.
+     * Shortens the epoch interval while much garbage is removed, to free
+     * the memory early; otherwise, the interval is lengthened again.
      *
-     * @param channel_id Channel Id.
-     * @return Local garbage queue.
+     * @param epoch_interval Current epoch interval.
+     * @param count_removed_resources Number of resources removed within the last epoch.
+     * @return The next epoch interval.
      */
-    [[nodiscard]] util::MPSCQueue<resource::ResourceInterface> &local_garbage(const std::uint16_t channel_id) noexcept
-    {
-        return _local_garbage_queues[channel_id].value();
-    }
+    [[nodiscard]] static std::chrono::microseconds adapt_epoch_interval(
+        std::chrono::microseconds epoch_interval, std::uint64_t count_removed_resources) noexcept;
+
+    /**
+     * Physically deletes all resources of a channel, removed in the given range of epochs.
+     * Resources removed in later epochs, that share a bucket with the range, are kept.
+     * Must be called by the owning channel.
+     *
+     * @param channel_id Channel owning the resources.
+     * @param from_epoch First epoch of the range.
+     * @param to_epoch Epoch after the range.
+     */
+    void reclaim(std::uint16_t channel_id, epoch_t from_epoch, epoch_t to_epoch) noexcept;
+
+    /**
+     * Reclaims all garbage, mainly right before shut down tasking.
+     */
+    void reclaim_all() noexcept;
 
     /**
      * Reset all local and the global epoch to initial values
@@ -151,33 +271,79 @@ private:
     // Local epochs, one for every channel.
     alignas(64) std::array<LocalEpoch, tasking::config::max_cores()> _local_epochs;
 
-    // Queue that holds all logically deleted objects in a global space.
-    alignas(64) util::MPSCQueue<resource::ResourceInterface> _global_garbage_queue;
+    // Local epochs of external participants, their usage, and the number of slots ever used.
+    alignas(64) std::array<LocalEpoch, config::max_external_epoch_participants()> _external_epochs;
+    std::array<std::atomic_bool, config::max_external_epoch_participants()> _is_external_epoch_used{};
+    std::atomic_uint16_t _count_external_epochs{0U};
+
+    // Logically deleted resources, one list for every channel.
+    alignas(64) std::array<LimboList, tasking::config::max_cores()> _limbo_lists;
 
-    // Queues for every worker thread. Logically deleted objects are stored here
-    // whenever local garbage collection is used.
-    alignas(64) std::array<util::aligned_t<util::MPSCQueue<resource::ResourceInterface>>,
-                           tasking::config::max_cores()> _local_garbage_queues;
+    // Task of every channel to release its limbo list; allocated once.
+    std::array<ReclaimEpochGarbageTask *, tasking::config::max_cores()> _reclaim_tasks{nullptr};
 
     /**
-     * Reclaims resources with regard to the epoch.
+     * Releases the limbo lists of all channels, whose resources were removed in
+     * epochs every channel has left, by spawning the task of every owning channel.
+     *
+     * @return Number of resources removed since the last call.
      */
-    void reclaim_epoch_garbage() noexcept;
+    std::uint64_t reclaim_epoch_garbage() noexcept;
 };
 
+/**
+ * Releases the limbo list of a single channel. Every channel owns one task,
+ * which is allocated with the epoch manager and spawned again whenever the
+ * channel holds garbage of epochs no channel is in anymore. Thus, the epoch
+ * manager never allocates tasks from the task allocator of any core.
+ */
 class ReclaimEpochGarbageTask final : public tasking::TaskInterface
 {
 public:
-    constexpr ReclaimEpochGarbageTask(EpochManager &epoch_manager, dynamic::Allocator &allocator) noexcept
-        : _epoch_manager(epoch_manager), _allocator(allocator)
-    {
-    }
+    explicit ReclaimEpochGarbageTask(EpochManager &epoch_manager) noexcept : _epoch_manager(epoch_manager) {}
     ~ReclaimEpochGarbageTask() noexcept override = default;
 
     tasking::TaskResult execute(std::uint16_t core_id, std::uint16_t channel_id) override;
 
+    /**
+     * @return True, while the task is spawned and not executed.
+     */
+    [[nodiscard]] bool is_spawned() const noexcept { return _is_spawned.load(std::memory_order_acquire); }
+
+    /**
+     * @return All resources removed in an epoch before this one are reclaimed; read only while not spawned.
+     */
+    [[nodiscard]] epoch_t reclaimed_epoch() const noexcept { return _reclaimed_epoch; }
+
+    /**
+     * Prepares the task to release the resources removed before the
+     * given epoch; the task has to be spawned afterwards.
+     *
+     * @param to_epoch Epoch after the range to release.
+     */
+    void reclaim_until(const epoch_t to_epoch) noexcept
+    {
+        _to_epoch = to_epoch;
+        _is_spawned.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Resets the reclaimed epoch, when the global epoch is reset.
+     */
+    void reset() noexcept
+    {
+        _reclaimed_epoch = 0U;
+        _to_epoch = 0U;
+    }
+
 private:
     EpochManager &_epoch_manager;
-    dynamic::Allocator &_allocator;
+
+    // Range of epochs to release, from the last released epoch up to (excluding) _to_epoch.
+    epoch_t _reclaimed_epoch{0U};
+    epoch_t _to_epoch{0U};
+
+    // Set while the task waits for execution; the epoch manager spawns it not twice.
+    std::atomic_bool _is_spawned{false};
 };
 } // namespace mx::memory::reclamation
\ No newline at end of file
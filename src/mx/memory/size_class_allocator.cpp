@@ -0,0 +1,254 @@
+#include "size_class_allocator.h"
+#include "global_heap.h"
+#include <algorithm>
+#include <mx/system/topology.h>
+#include <numa.h>
+
+using namespace mx::memory::dynamic;
+
+SizeClassAllocator::SizeClassAllocator()
+{
+    constexpr auto arena_size = config::size_class_arena_size() * COUNT_CLASSES;
+
+    for (auto numa_node_id = 0U; numa_node_id <= system::topology::max_node_id(); ++numa_node_id)
+    {
+        if (numa_node_id < config::max_numa_nodes())
+        {
+            // Without address space, objects are allocated by the allocation blocks.
+            _arenas[numa_node_id] = GlobalHeap::reserve(config::size_class_arena_size(), arena_size);
+            if (_arenas[numa_node_id] != nullptr)
+            {
+                numa_tonode_memory(_arenas[numa_node_id], arena_size, int(numa_node_id));
+            }
+        }
+    }
+
+    this->initialize();
+}
+
+SizeClassAllocator::~SizeClassAllocator()
+{
+    for (auto *arena : _arenas)
+    {
+        if (arena != nullptr)
+        {
+            GlobalHeap::free(arena, config::size_class_arena_size() * COUNT_CLASSES);
+        }
+    }
+}
+
+void *SizeClassAllocator::allocate(const std::uint8_t numa_node_id, const std::uint8_t size_class_id,
+                                   const std::size_t object_size) noexcept
+{
+    auto &core_cache = this->_core_caches[system::topology::core_id() % tasking::config::max_cores()];
+    auto &free_list = core_cache.free_lists[numa_node_id][size_class_id];
+
+    core_cache.lock.lock();
+    if (free_list.first == nullptr)
+    {
+        SizeClassAllocator::refill(this->_size_classes[numa_node_id][size_class_id], object_size, free_list);
+    }
+
+    auto *object = free_list.first;
+    if (object != nullptr)
+    {
+        free_list.first = object->next;
+        --free_list.count;
+        ++core_cache.count_allocated_objects;
+    }
+    core_cache.lock.unlock();
+
+    return static_cast<void *>(object);
+}
+
+void SizeClassAllocator::free(void *pointer) noexcept
+{
+    const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+    const auto numa_node_id = this->numa_node_id(address);
+    const auto size_class_id = (address - reinterpret_cast<std::uintptr_t>(this->_arenas[numa_node_id])) /
+                               config::size_class_arena_size();
+
+    auto &core_cache = this->_core_caches[system::topology::core_id() % tasking::config::max_cores()];
+    auto &free_list = core_cache.free_lists[numa_node_id][size_class_id];
+
+    core_cache.lock.lock();
+    auto *object = static_cast<FreeObject *>(pointer);
+    object->next = free_list.first;
+    free_list.first = object;
+    --core_cache.count_allocated_objects;
+
+    if (++free_list.count > config::size_class_cache_size())
+    {
+        SizeClassAllocator::flush(free_list, this->_size_classes[numa_node_id][size_class_id]);
+    }
+    core_cache.lock.unlock();
+}
+
+bool SizeClassAllocator::is_free() noexcept
+{
+    auto count_allocated_objects = std::int64_t{0};
+    for (auto &core_cache : this->_core_caches)
+    {
+        core_cache.lock.lock();
+        count_allocated_objects += core_cache.count_allocated_objects;
+        core_cache.lock.unlock();
+    }
+
+    return count_allocated_objects == 0;
+}
+
+void SizeClassAllocator::reset() noexcept
+{
+    for (auto &core_cache : this->_core_caches)
+    {
+        core_cache.lock.lock();
+        core_cache.count_allocated_objects = 0;
+        for (auto &numa_free_lists : core_cache.free_lists)
+        {
+            numa_free_lists.fill(FreeList{});
+        }
+        core_cache.lock.unlock();
+    }
+
+    for (auto *arena : _arenas)
+    {
+        if (arena != nullptr)
+        {
+            GlobalHeap::release(arena, config::size_class_arena_size() * COUNT_CLASSES);
+        }
+    }
+
+    this->initialize();
+}
+
+std::size_t SizeClassAllocator::object_size(const void *pointer) const noexcept
+{
+    const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+    const auto arena_address = reinterpret_cast<std::uintptr_t>(this->_arenas[this->numa_node_id(address)]);
+    const auto size_class_id = (address - arena_address) / config::size_class_arena_size();
+
+    return size_class_id < SIZE_CLASSES
+               ? MIN_SIZE << size_class_id
+               : this->_pool_object_sizes[size_class_id - SIZE_CLASSES].load(std::memory_order_relaxed);
+}
+
+std::uint64_t SizeClassAllocator::count_free_objects(const std::uint8_t numa_node_id) const noexcept
+{
+    // Counts are read without latching; the result is a snapshot.
+    auto count_free_objects = std::uint64_t{0U};
+    for (const auto &core_cache : this->_core_caches)
+    {
+        for (const auto &free_list : core_cache.free_lists[numa_node_id])
+        {
+            count_free_objects += free_list.count;
+        }
+    }
+
+    for (const auto &size_class : this->_size_classes[numa_node_id])
+    {
+        count_free_objects += size_class.free_list.count;
+    }
+
+    return count_free_objects;
+}
+
+std::uint8_t SizeClassAllocator::numa_node_id(const std::uintptr_t address) const noexcept
+{
+    constexpr auto arena_size = config::size_class_arena_size() * COUNT_CLASSES;
+
+    for (auto numa_node_id = 0U; numa_node_id < config::max_numa_nodes(); ++numa_node_id)
+    {
+        const auto arena_address = reinterpret_cast<std::uintptr_t>(this->_arenas[numa_node_id]);
+        if (arena_address != 0U && address >= arena_address && address < arena_address + arena_size)
+        {
+            return std::uint8_t(numa_node_id);
+        }
+    }
+
+    return config::max_numa_nodes();
+}
+
+void SizeClassAllocator::initialize() noexcept
+{
+    for (auto numa_node_id = 0U; numa_node_id < config::max_numa_nodes(); ++numa_node_id)
+    {
+        const auto arena_address = reinterpret_cast<std::uintptr_t>(this->_arenas[numa_node_id]);
+        for (auto size_class_id = 0U; size_class_id < COUNT_CLASSES; ++size_class_id)
+        {
+            auto &size_class = this->_size_classes[numa_node_id][size_class_id];
+            size_class.lock.lock();
+            size_class.free_list = FreeList{};
+            if (arena_address != 0U)
+            {
+                size_class.next_unused_object = arena_address + size_class_id * config::size_class_arena_size();
+                size_class.end = size_class.next_unused_object + config::size_class_arena_size();
+            }
+            size_class.lock.unlock();
+        }
+    }
+}
+
+void SizeClassAllocator::refill(SizeClass &size_class, const std::size_t object_size, FreeList &free_list) noexcept
+{
+    constexpr auto count_objects = config::size_class_cache_size() / 2U;
+
+    size_class.lock.lock();
+
+    // Take objects given back by other cores first...
+    while (free_list.count < count_objects && size_class.free_list.first != nullptr)
+    {
+        auto *object = size_class.free_list.first;
+        size_class.free_list.first = object->next;
+        --size_class.free_list.count;
+
+        object->next = free_list.first;
+        free_list.first = object;
+        ++free_list.count;
+    }
+
+    // ... and carve never used objects from the address space.
+    if (free_list.count < count_objects && size_class.next_unused_object < size_class.end)
+    {
+        const auto count_unused_objects =
+            std::min<std::size_t>(count_objects - free_list.count,
+                                  (size_class.end - size_class.next_unused_object) / object_size);
+
+        for (auto i = count_unused_objects; i > 0U; --i)
+        {
+            auto *object = reinterpret_cast<FreeObject *>(size_class.next_unused_object + (i - 1U) * object_size);
+            object->next = free_list.first;
+            free_list.first = object;
+        }
+        size_class.next_unused_object += count_unused_objects * object_size;
+        free_list.count += count_unused_objects;
+    }
+
+    size_class.lock.unlock();
+}
+
+void SizeClassAllocator::flush(FreeList &free_list, SizeClass &size_class) noexcept
+{
+    // Keep the recently freed objects, which may be still in the CPU cache.
+    auto *last_kept = free_list.first;
+    for (auto i = 1U; i < free_list.count / 2U; ++i)
+    {
+        last_kept = last_kept->next;
+    }
+
+    auto *first_flushed = last_kept->next;
+    auto *last_flushed = first_flushed;
+    while (last_flushed->next != nullptr)
+    {
+        last_flushed = last_flushed->next;
+    }
+    const auto count_flushed = free_list.count - free_list.count / 2U;
+
+    last_kept->next = nullptr;
+    free_list.count -= count_flushed;
+
+    size_class.lock.lock();
+    last_flushed->next = size_class.free_list.first;
+    size_class.free_list.first = first_flushed;
+    size_class.free_list.count += count_flushed;
+    size_class.lock.unlock();
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "alignment_helper.h"
+#include "config.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mx/synchronization/spinlock.h>
+#include <mx/tasking/config.h>
+
+namespace mx::memory::dynamic {
+/**
+ * Front end of the dynamic allocator for small objects (up to 4kb,
+ * aligned to the cache line). Every size class owns a range of the
+ * address space per NUMA node, which is reserved up front and carved
+ * by a bump pointer. Thus, the size class and NUMA node of an object
+ * are known by its address and objects need no header.
+ * Every core caches a few free objects per size class and NUMA node;
+ * only refilling and flushing the cache access the (latched) central
+ * free lists.
+ * Besides the size classes, resource types of a fixed size may own
+ * a pool, which is managed like a size class sized exactly to the type.
+ */
+class SizeClassAllocator
+{
+public:
+    SizeClassAllocator();
+    ~SizeClassAllocator();
+
+    /**
+     * @param alignment Requested alignment.
+     * @param size Requested size.
+     * @return True, when objects of the given size and alignment are served by size classes.
+     */
+    [[nodiscard]] static constexpr bool is_size_class(const std::size_t alignment, const std::size_t size) noexcept
+    {
+        return alignment <= MIN_SIZE && size <= MAX_SIZE;
+    }
+
+    /**
+     * Allocates an object from the size class fitting the given size.
+     *
+     * @param numa_node_id NUMA region to allocate the object in.
+     * @param size Requested size.
+     * @return Pointer to the allocated object; nullptr, when the size class is exhausted.
+     */
+    [[nodiscard]] void *allocate(std::uint8_t numa_node_id, std::size_t size) noexcept
+    {
+        const auto size_class_id = SizeClassAllocator::size_class(size);
+        return this->allocate(numa_node_id, size_class_id, MIN_SIZE << size_class_id);
+    }
+
+    /**
+     * Allocates an object from the pool of the given type. The first types
+     * allocated get a pool (see config::max_typed_pools()), whose objects
+     * are as large as the type, rounded up to the cache line.
+     *
+     * @param numa_node_id NUMA region to allocate the object in.
+     * @return Pointer to the allocated object; nullptr, when the type has no pool or the pool is exhausted.
+     */
+    template <typename T> [[nodiscard]] void *allocate(const std::uint8_t numa_node_id) noexcept
+    {
+        static_assert(SizeClassAllocator::is_size_class(alignof(T), sizeof(T)), "Type is too large for a pool.");
+
+        const auto pool_id = SizeClassAllocator::pool_id<T>();
+        if (pool_id >= config::max_typed_pools())
+        {
+            return nullptr;
+        }
+
+        if constexpr (config::allocator_statistics())
+        {
+            _pool_object_sizes[pool_id].store(alignment_helper::next_multiple(sizeof(T), std::size_t(MIN_SIZE)),
+                                              std::memory_order_relaxed);
+        }
+
+        return this->allocate(numa_node_id, SIZE_CLASSES + pool_id,
+                              alignment_helper::next_multiple(sizeof(T), std::size_t(MIN_SIZE)));
+    }
+
+    /**
+     * Frees an object allocated by this allocator.
+     *
+     * @param pointer Pointer to the object.
+     */
+    void free(void *pointer) noexcept;
+
+    /**
+     * @param pointer Pointer to memory.
+     * @return True, when the memory was allocated by this allocator.
+     */
+    [[nodiscard]] bool contains(const void *pointer) const noexcept
+    {
+        return numa_node_id(reinterpret_cast<std::uintptr_t>(pointer)) < config::max_numa_nodes();
+    }
+
+    /**
+     * @param pointer Pointer to an object allocated by this allocator.
+     * @return Size of the object, which is the size of its size class or pool.
+     */
+    [[nodiscard]] std::size_t object_size(const void *pointer) const noexcept;
+
+    /**
+     * @param pointer Pointer to an object allocated by this allocator.
+     * @return NUMA region of the object.
+     */
+    [[nodiscard]] std::uint8_t numa_node_id(const void *pointer) const noexcept
+    {
+        return numa_node_id(reinterpret_cast<std::uintptr_t>(pointer));
+    }
+
+    /**
+     * @param numa_node_id NUMA region.
+     * @return Number of free objects (cached by cores and held by the
+     *         size classes and pools) on the given NUMA region.
+     */
+    [[nodiscard]] std::uint64_t count_free_objects(std::uint8_t numa_node_id) const noexcept;
+
+    /**
+     * @return True, if no object is in use.
+     */
+    [[nodiscard]] bool is_free() noexcept;
+
+    /**
+     * Releases all allocated memory; all objects become invalid.
+     */
+    void reset() noexcept;
+
+private:
+    // Number and sizes of size classes: 64b, 128b, ..., 4kb.
+    inline static constexpr auto SIZE_CLASSES = 7U;
+    inline static constexpr auto MIN_SIZE = 64U;
+    inline static constexpr auto MAX_SIZE = MIN_SIZE << (SIZE_CLASSES - 1U);
+
+    // Size classes followed by the typed pools, each with its own address space.
+    inline static constexpr auto COUNT_CLASSES = SIZE_CLASSES + config::max_typed_pools();
+
+    // Number of types that requested a pool so far.
+    inline static std::atomic_uint16_t _count_pools{0U};
+
+    /**
+     * Free object, linked in a list of free objects.
+     */
+    struct FreeObject
+    {
+        FreeObject *next;
+    };
+
+    /**
+     * List of free objects of one size class.
+     */
+    struct FreeList
+    {
+        FreeObject *first{nullptr};
+        std::uint32_t count{0U};
+    };
+
+    /**
+     * Free objects cached by a single core.
+     */
+    struct alignas(64) CoreCache
+    {
+        synchronization::Spinlock lock;
+
+        // Objects allocated minus objects freed at this core.
+        std::int64_t count_allocated_objects{0};
+
+        std::array<std::array<FreeList, COUNT_CLASSES>, config::max_numa_nodes()> free_lists{};
+    };
+
+    /**
+     * Objects of one size class on one NUMA node, shared by all cores.
+     */
+    struct alignas(64) SizeClass
+    {
+        synchronization::Spinlock lock;
+
+        // Free objects returned by cores.
+        FreeList free_list;
+
+        // Next object that was never used and the end of the address space of the size class.
+        std::uintptr_t next_unused_object{0U};
+        std::uintptr_t end{0U};
+    };
+
+    // Address space of every NUMA node; nullptr, when not reserved.
+    std::array<void *, config::max_numa_nodes()> _arenas{nullptr};
+
+    // Size classes and typed pools of every NUMA node.
+    std::array<std::array<SizeClass, COUNT_CLASSES>, config::max_numa_nodes()> _size_classes{};
+
+    // Caches of every core.
+    std::array<CoreCache, tasking::config::max_cores()> _core_caches{};
+
+    // Size of the objects of every typed pool; only known with statistics enabled.
+    std::array<std::atomic_uint32_t, config::max_typed_pools()> _pool_object_sizes{};
+
+    /**
+     * @param size Requested size.
+     * @return Index of the smallest size class fitting the size.
+     */
+    [[nodiscard]] static std::uint8_t size_class(const std::size_t size) noexcept
+    {
+        return size <= MIN_SIZE ? 0U : std::uint8_t(64U - __builtin_clzl((size - 1U) / MIN_SIZE));
+    }
+
+    /**
+     * @return Pool of the given type; assigned on first call.
+     */
+    template <typename T> [[nodiscard]] static std::uint16_t pool_id() noexcept
+    {
+        static const auto pool_id = _count_pools.fetch_add(1U, std::memory_order_relaxed);
+        return pool_id;
+    }
+
+    /**
+     * Allocates an object from the given size class or pool.
+     *
+     * @param numa_node_id NUMA region to allocate the object in.
+     * @param size_class_id Size class or pool.
+     * @param object_size Size of the objects of the size class or pool.
+     * @return Pointer to the allocated object; nullptr, when the size class or pool is exhausted.
+     */
+    [[nodiscard]] void *allocate(std::uint8_t numa_node_id, std::uint8_t size_class_id,
+                                 std::size_t object_size) noexcept;
+
+    /**
+     * @param address Address of an object.
+     * @return NUMA node whose address space contains the address; max_numa_nodes(), if none.
+     */
+    [[nodiscard]] std::uint8_t numa_node_id(std::uintptr_t address) const noexcept;
+
+    /**
+     * Initializes the size classes of all reserved address spaces.
+     */
+    void initialize() noexcept;
+
+    /**
+     * Fills the cached list with objects from the size class.
+     *
+     * @param size_class Size class to take objects from.
+     * @param object_size Size of the objects.
+     * @param free_list Cached list.
+     */
+    static void refill(SizeClass &size_class, std::size_t object_size, FreeList &free_list) noexcept;
+
+    /**
+     * Moves half of the cached objects back to the size class.
+     *
+     * @param free_list Cached list.
+     * @param size_class Size class to give the objects back.
+     */
+    static void flush(FreeList &free_list, SizeClass &size_class) noexcept;
+};
+} // namespace mx::memory::dynamic
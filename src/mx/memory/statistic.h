@@ -0,0 +1,130 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mx/tasking/config.h>
+#include <mx/util/aligned_t.h>
+
+namespace mx::memory {
+/**
+ * Collector for allocator statistics (allocated and freed objects and bytes, ...),
+ * if enabled by config::allocator_statistics(). Every worker counts in the slot of
+ * its channel (see bind()); all other threads share one further slot.
+ * Objects (and bytes) in use are the difference of allocated and freed ones.
+ */
+class Statistic
+{
+public:
+    using counter_line_t = util::aligned_t<std::array<std::atomic_uint64_t, 6>>;
+
+    // Slot of threads, that are not bound to a channel.
+    inline static constexpr auto EXTERNAL_SLOT = std::uint16_t(tasking::config::max_cores());
+
+    enum Counter : std::uint8_t
+    {
+        AllocatedObjects,
+        FreedObjects,
+        AllocatedBytes,
+        FreedBytes,
+
+        // Objects allocated on another NUMA region than the one of the allocating core.
+        RemoteAllocations,
+
+        // Objects freed by a core of another NUMA region than the one the object is allocated on.
+        RemoteFrees
+    };
+
+    constexpr Statistic() noexcept = default;
+    ~Statistic() noexcept = default;
+
+    /**
+     * Binds the calling thread to the slot of the given channel.
+     * Every worker binds itself to its channel before executing tasks.
+     *
+     * @param channel_id Channel of the calling worker.
+     */
+    static void bind(const std::uint16_t channel_id) noexcept { _slot = channel_id; }
+
+    /**
+     * Unbinds the calling thread; further counts go to the slot of external threads.
+     */
+    static void unbind() noexcept { _slot = EXTERNAL_SLOT; }
+
+    /**
+     * Adds the given value to the template-given counter of the calling thread.
+     * Slots of channels are written by their worker only; the slot of
+     * external threads is shared and, thus, incremented atomically.
+     *
+     * @param value Value to add.
+     */
+    template <Counter C> void add(const std::uint64_t value = 1U) noexcept
+    {
+        const auto slot = _slot;
+        auto &counter = _counter[slot].value()[static_cast<std::uint8_t>(C)];
+        if (slot == EXTERNAL_SLOT)
+        {
+            counter.fetch_add(value, std::memory_order_relaxed);
+        }
+        else
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Read the given counter for a given slot.
+     * @param counter Counter to read.
+     * @param slot Channel the counter is for, or EXTERNAL_SLOT.
+     * @return Value of the counter.
+     */
+    [[nodiscard]] std::uint64_t get(const Counter counter, const std::uint16_t slot) const noexcept
+    {
+        return _counter[slot].value()[static_cast<std::uint8_t>(counter)].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Read and aggregate the counter for all channels and external threads.
+     * @param counter Counter to read.
+     * @return Value of the counter for all channels and external threads.
+     */
+    [[nodiscard]] std::uint64_t get(const Counter counter) const noexcept
+    {
+        std::uint64_t sum = 0U;
+        for (auto slot = 0U; slot < _counter.size(); ++slot)
+        {
+            sum += get(counter, std::uint16_t(slot));
+        }
+
+        return sum;
+    }
+
+private:
+    // Slot of the calling thread.
+    inline static thread_local std::uint16_t _slot{EXTERNAL_SLOT};
+
+    // Counters of every channel and, finally, of all external threads.
+    std::array<counter_line_t, tasking::config::max_cores() + 1U> _counter{};
+};
+
+/**
+ * State of the memory an allocator holds on a single NUMA region.
+ */
+struct NodeStatistic
+{
+    // Memory taken from the global heap.
+    std::uint64_t reserved_bytes{0U};
+
+    // Chunks taken by cores (task allocator) or allocation blocks (resource allocator).
+    std::uint64_t count_chunks{0U};
+
+    // Chunks without any object in use (task allocator).
+    std::uint64_t count_free_chunks{0U};
+
+    // Free memory and largest free region within the allocation blocks (resource allocator).
+    std::uint64_t free_bytes{0U};
+    std::uint64_t largest_free_block{0U};
+
+    // Objects in the free lists of the size classes (resource allocator).
+    std::uint64_t count_free_objects{0U};
+};
+} // namespace mx::memory
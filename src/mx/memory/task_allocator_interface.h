@@ -1,5 +1,7 @@
 #pragma once
 
+#include "config.h"
+#include "statistic.h"
 #include <cstdint>
 #include <cstdlib>
 
@@ -21,12 +23,42 @@ public:
      */
     [[nodiscard]] virtual void *allocate(std::uint16_t core_id) = 0;
 
+    /**
+     * Allocates memory for the given core on the given NUMA region.
+     * @param core_id Core to allocate memory for.
+     * @param numa_node_id NUMA region the memory should be allocated on.
+     * @return Allocated memory.
+     */
+    [[nodiscard]] virtual void *allocate(std::uint16_t core_id, std::uint8_t numa_node_id) = 0;
+
     /**
      * Frees the memory at the given core.
      * @param core_id Core to store free memory.
      * @param address Address to free.
      */
     virtual void free(std::uint16_t core_id, void *address) noexcept = 0;
+
+    /**
+     * Returns memory freed by the given core, that belongs to other cores.
+     * @param core_id Core that freed the memory.
+     */
+    virtual void flush(std::uint16_t core_id) noexcept = 0;
+
+    /**
+     * Releases memory that is not used any more to the operating system.
+     */
+    virtual void trim() noexcept = 0;
+
+    /**
+     * @return Counters of allocated and freed tasks per channel.
+     */
+    [[nodiscard]] virtual const Statistic &statistic() const noexcept = 0;
+
+    /**
+     * @param numa_node_id NUMA region.
+     * @return State of the memory held on the given NUMA region.
+     */
+    [[nodiscard]] virtual NodeStatistic statistic(std::uint8_t numa_node_id) const noexcept = 0;
 };
 
 /**
@@ -41,12 +73,62 @@ public:
     /**
      * @return Allocated memory using systems malloc (but aligned).
      */
-    [[nodiscard]] void *allocate(const std::uint16_t /*core_id*/) override { return std::aligned_alloc(64U, S); }
+    [[nodiscard]] void *allocate(const std::uint16_t /*core_id*/) override
+    {
+        if constexpr (config::allocator_statistics())
+        {
+            _statistic.add<Statistic::AllocatedObjects>();
+            _statistic.add<Statistic::AllocatedBytes>(S);
+        }
+
+        return std::aligned_alloc(64U, S);
+    }
+
+    /**
+     * @return Allocated memory using systems malloc (but aligned), which is not NUMA aware.
+     */
+    [[nodiscard]] void *allocate(const std::uint16_t core_id, const std::uint8_t /*numa_node_id*/) override
+    {
+        return allocate(core_id);
+    }
 
     /**
      * Frees the given memory using systems free.
      * @param address Memory to free.
      */
-    void free(const std::uint16_t /*core_id*/, void *address) noexcept override { std::free(address); }
+    void free(const std::uint16_t /*core_id*/, void *address) noexcept override
+    {
+        if constexpr (config::allocator_statistics())
+        {
+            _statistic.add<Statistic::FreedObjects>();
+            _statistic.add<Statistic::FreedBytes>(S);
+        }
+
+        std::free(address);
+    }
+
+    /**
+     * Memory is returned by the system allocator.
+     */
+    void flush(const std::uint16_t /*core_id*/) noexcept override {}
+
+    /**
+     * Memory is released by the system allocator.
+     */
+    void trim() noexcept override {}
+
+    [[nodiscard]] const Statistic &statistic() const noexcept override { return _statistic; }
+
+    /**
+     * @return Nothing; the memory is held by the system allocator.
+     */
+    [[nodiscard]] NodeStatistic statistic(const std::uint8_t /*numa_node_id*/) const noexcept override
+    {
+        return NodeStatistic{};
+    }
+
+private:
+    // Counters of allocated and freed tasks.
+    Statistic _statistic;
 };
 } // namespace mx::memory
\ No newline at end of file
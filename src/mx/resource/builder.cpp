@@ -1,8 +1,41 @@
 #include "builder.h"
+#include <algorithm>
+#include <array>
 #include <mx/synchronization/primitive_matrix.h>
 
 using namespace mx::resource;
 
+template <typename L>
+std::uint16_t Builder::place(const resource::hint &hint, const std::uint64_t ticket, L &&load) const
+{
+    const auto count_channels = this->_scheduler.count_channels();
+    auto channel_id = std::uint16_t(ticket % count_channels);
+
+    if (hint.has_affinity_channel_id())
+    {
+        // Place the resource next to related resources, unless
+        // the affine channel is clearly more loaded.
+        const auto affinity_channel_id = hint.affinity_channel_id();
+        if (load(affinity_channel_id) <= load(channel_id) + tasking::config::resource_affinity_tolerance())
+        {
+            channel_id = affinity_channel_id;
+        }
+    }
+    else if (count_channels > 1U)
+    {
+        // Choose the less loaded of two channels: the round robin one and
+        // another one, which is shifted with every round over all channels.
+        const auto candidate_channel_id =
+            std::uint16_t((channel_id + 1U + (ticket / count_channels) % (count_channels - 1U)) % count_channels);
+        if (load(candidate_channel_id) < load(channel_id))
+        {
+            channel_id = candidate_channel_id;
+        }
+    }
+
+    return channel_id;
+}
+
 std::pair<std::uint16_t, std::uint8_t> Builder::schedule(const resource::hint &hint)
 {
     // Scheduling was done by the hint.
@@ -12,21 +45,93 @@ std::pair<std::uint16_t, std::uint8_t> Builder::schedule(const resource::hint &h
         return std::make_pair(hint.channel_id(), this->_scheduler.numa_node_id(hint.channel_id()));
     }
 
-    // Schedule resources round robin to the channels.
+    const auto ticket = this->_round_robin_channel_id.fetch_add(1U, std::memory_order_relaxed);
+    const auto channel_id = this->place(hint, ticket, [this](const std::uint16_t channel_id_) {
+        return this->_scheduler.load(channel_id_);
+    });
+    this->_scheduler.predict_usage(channel_id, hint.access_frequency());
+
+    const auto numa_node_id = hint.has_numa_node_id() ? hint.numa_node_id() : this->_scheduler.numa_node_id(channel_id);
+
+    return std::make_pair(channel_id, numa_node_id);
+}
+
+void Builder::schedule(const resource::hint &hint, std::vector<std::pair<std::uint16_t, std::uint8_t>> &channels)
+{
+    // Scheduling was done by the hint.
+    if (hint.has_channel_id())
+    {
+        this->_scheduler.predict_usage(hint.channel_id(), hint.access_frequency(), channels.size());
+        std::fill(channels.begin(), channels.end(),
+                  std::make_pair(hint.channel_id(), this->_scheduler.numa_node_id(hint.channel_id())));
+        return;
+    }
+
+    // Reserve the round robin tickets of all resources at once.
+    const auto first_ticket = this->_round_robin_channel_id.fetch_add(channels.size(), std::memory_order_relaxed);
+
+    // Every resource is placed like a single one. Instead of predicting the usage per
+    // resource, the load of every channel is read once and the resources placed by
+    // this call are added locally; the usage is predicted once per channel afterwards.
     const auto count_channels = this->_scheduler.count_channels();
-    auto channel_id = this->_round_robin_channel_id.fetch_add(1U, std::memory_order_relaxed) % count_channels;
+    const auto weight = tasking::ChannelOccupancy::weight(hint.access_frequency());
+    auto load = std::array<std::uint64_t, tasking::config::max_cores()>{0U};
+    for (auto channel_id = 0U; channel_id < count_channels; ++channel_id)
+    {
+        load[channel_id] = this->_scheduler.load(channel_id);
+    }
 
-    // If the chosen channel contains an excessive accessed resource, get another.
-    if (count_channels > 2U && hint.isolation_level() == synchronization::isolation_level::Exclusive &&
-        this->_scheduler.has_excessive_usage_prediction(channel_id))
+    auto count_resources = std::array<std::uint64_t, tasking::config::max_cores()>{0U};
+    for (auto i = 0U; i < channels.size(); ++i)
     {
-        channel_id = this->_round_robin_channel_id.fetch_add(1U, std::memory_order_relaxed) % count_channels;
+        const auto channel_id = this->place(hint, first_ticket + i, [&load](const std::uint16_t channel_id_) {
+            return load[channel_id_];
+        });
+        const auto numa_node_id =
+            hint.has_numa_node_id() ? hint.numa_node_id() : this->_scheduler.numa_node_id(channel_id);
+        channels[i] = std::make_pair(channel_id, numa_node_id);
+        load[channel_id] += weight;
+        ++count_resources[channel_id];
     }
-    this->_scheduler.predict_usage(channel_id, hint.access_frequency());
 
-    const auto numa_node_id = hint.has_numa_node_id() ? hint.numa_node_id() : this->_scheduler.numa_node_id(channel_id);
+    // Predict the usage once per channel.
+    for (auto channel_id = 0U; channel_id < count_channels; ++channel_id)
+    {
+        if (count_resources[channel_id] > 0U)
+        {
+            this->_scheduler.predict_usage(channel_id, hint.access_frequency(), count_resources[channel_id]);
+        }
+    }
+}
 
-    return std::make_pair(channel_id, numa_node_id);
+void Builder::allocate(const std::vector<std::pair<std::uint16_t, std::uint8_t>> &channels, const std::size_t size,
+                       std::vector<void *> &objects)
+{
+    auto count_resources = std::array<std::size_t, memory::config::max_numa_nodes()>{0U};
+    for (const auto &[_, numa_node_id] : channels)
+    {
+        ++count_resources[numa_node_id];
+    }
+
+    // Allocate the resources of every NUMA region at once...
+    auto numa_memory = std::array<std::vector<void *>, memory::config::max_numa_nodes()>{};
+    for (auto numa_node_id = 0U; numa_node_id < memory::config::max_numa_nodes(); ++numa_node_id)
+    {
+        if (count_resources[numa_node_id] > 0U)
+        {
+            numa_memory[numa_node_id].resize(count_resources[numa_node_id]);
+            this->_allocator.allocate(std::uint8_t(numa_node_id), 64U, size, count_resources[numa_node_id],
+                                      numa_memory[numa_node_id].data());
+        }
+    }
+
+    // ... and hand them out in order of the resources.
+    auto next_object = std::array<std::size_t, memory::config::max_numa_nodes()>{0U};
+    for (auto i = 0U; i < channels.size(); ++i)
+    {
+        const auto numa_node_id = channels[i].second;
+        objects[i] = numa_memory[numa_node_id][next_object[numa_node_id]++];
+    }
 }
 
 mx::synchronization::primitive Builder::isolation_level_to_synchronization_primitive(const hint &hint) noexcept
@@ -39,6 +144,18 @@ mx::synchronization::primitive Builder::isolation_level_to_synchronization_primi
                                                                   hint.read_write_ratio());
     }
 
+    // Queue-based latches serialize all accesses, which
+    // satisfies both, strict and relaxed isolation levels.
+    if (hint == synchronization::protocol::MCSLatch)
+    {
+        return synchronization::primitive::MCSLatch;
+    }
+
+    if (hint == synchronization::protocol::CohortLatch)
+    {
+        return synchronization::primitive::CohortLatch;
+    }
+
     // The developer hinted a specific protocol (latched, queued, ...)
     // and a relaxed isolation level.
     if (hint == synchronization::isolation_level::ExclusiveWriter)
@@ -49,6 +166,8 @@ mx::synchronization::primitive Builder::isolation_level_to_synchronization_primi
             return synchronization::primitive::ReaderWriterLatch;
         case synchronization::protocol::OLFIT:
             return synchronization::primitive::OLFIT;
+        case synchronization::protocol::Adaptive:
+            return synchronization::primitive::Adaptive;
         default:
             return synchronization::primitive::ScheduleWriter;
         }
@@ -63,4 +182,9 @@ mx::synchronization::primitive Builder::isolation_level_to_synchronization_primi
     }
 
     return mx::synchronization::primitive::None;
-}
\ No newline at end of file
+}
+mx::synchronization::primitive Builder::initial_adaptive_primitive(const hint &hint) noexcept
+{
+    return synchronization::PrimitiveMatrix::select_primitive(synchronization::isolation_level::ExclusiveWriter,
+                                                              hint.access_frequency(), hint.read_write_ratio());
+}
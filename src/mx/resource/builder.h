@@ -3,6 +3,7 @@
 #include <array>
 #include <atomic>
 #include <cstdint>
+#include <mx/memory/alignment_helper.h>
 #include <mx/memory/dynamic_size_allocator.h>
 #include <mx/memory/global_heap.h>
 #include <mx/tasking/config.h>
@@ -10,6 +11,7 @@
 #include <mx/util/aligned_t.h>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace mx::resource {
 /**
@@ -19,6 +21,8 @@ namespace mx::resource {
  */
 class Builder
 {
+    static_assert(tasking::config::max_cores() <= 512U, "Channel ids are stored with 9 bits in resource pointers.");
+
 public:
     Builder(tasking::Scheduler &scheduler, memory::dynamic::Allocator &allocator) noexcept
         : _allocator(allocator), _scheduler(scheduler)
@@ -51,13 +55,76 @@ public:
         }
 #endif
 
+        return this->build_object<T>(size, hint, std::forward<Args>(arguments)...);
+    }
+
+    /**
+     * Builds a set of data objects of given type with given size and
+     * arguments; all objects share the same hint. Channels are assigned
+     * in a single pass and the objects of every NUMA region are carved
+     * from one allocation, instead of allocating every object separately.
+     * Interleaved and replicated objects are built like single objects.
+     *
+     * @param count Number of data objects.
+     * @param size Size of every data object.
+     * @param hint Hint for scheduling and synchronization.
+     * @param arguments Arguments to the constructor of every data object.
+     * @return Tagged pointers holding the synchronization, assigned channel and pointer;
+     *         pointers of objects that could not be allocated are empty.
+     */
+    template <typename T, typename... Args>
+    std::vector<ptr> build(const std::size_t count, const std::size_t size, resource::hint &&hint,
+                           const Args &... arguments) noexcept
+    {
+#ifndef NDEBUG
+        if (hint != synchronization::isolation_level::None &&
+            (hint != synchronization::isolation_level::Exclusive || hint != synchronization::protocol::Queue))
+        {
+            if constexpr (std::is_base_of<ResourceInterface, T>::value == false)
+            {
+                assert(false && "Type must be inherited from mx::resource::ResourceInterface");
+            }
+        }
+#endif
+
+        // Interleaved and replicated objects are mapped one by one.
+        if (hint.placement() != resource::hint::memory_placement::local)
+        {
+            auto resources = std::vector<ptr>{};
+            resources.reserve(count);
+            for (auto i = 0U; i < count; ++i)
+            {
+                resources.emplace_back(this->build_object<T>(size, hint, arguments...));
+            }
+
+            return resources;
+        }
+
         const auto synchronization_method = Builder::isolation_level_to_synchronization_primitive(hint);
 
-        const auto [channel_id, numa_node_id] = schedule(hint);
-        const auto resource_information = information{channel_id, synchronization_method};
+        auto channels = std::vector<std::pair<std::uint16_t, std::uint8_t>>(count);
+        schedule(hint, channels);
+
+        auto objects = std::vector<void *>(count);
+        allocate(channels, size, objects);
+
+        auto resources = std::vector<ptr>{};
+        resources.reserve(count);
+        for (auto i = 0U; i < count; ++i)
+        {
+            const auto resource_information = information{channels[i].first, synchronization_method, hint};
+            if (objects[i] == nullptr)
+            {
+                resources.emplace_back(nullptr, resource_information);
+                continue;
+            }
+
+            auto *object = new (objects[i]) T(arguments...);
+            Builder::initialize_synchronization(object, synchronization_method, hint);
+            resources.emplace_back(object, resource_information);
+        }
 
-        return ptr{new (_allocator.allocate(numa_node_id, 64U, size)) T(std::forward<Args>(arguments)...),
-                   resource_information};
+        return resources;
     }
 
     /**
@@ -83,8 +150,32 @@ public:
 
         const auto synchronization_method = Builder::isolation_level_to_synchronization_primitive(hint);
         const auto [channel_id, _] = schedule(hint);
+        Builder::initialize_synchronization(object, synchronization_method, hint);
 
-        return ptr{object, information{channel_id, synchronization_method}};
+        return ptr{object, information{channel_id, synchronization_method, hint}};
+    }
+
+    /**
+     * Restores a data object of a persistent heap after a restart. Objects with
+     * virtual functions are constructed in place by their restore constructor
+     * (see restore_t), which rebuilds the pointer to the virtual table and resets
+     * the synchronization state. The object is scheduled to a channel, since the
+     * channels of the previous run are gone.
+     *
+     * @param object Object on the persistent heap.
+     * @param hint Hint for scheduling and synchronization.
+     * @return Tagged pointer holding the synchronization, assigned channel and pointer.
+     */
+    template <typename T> ptr restore(T *object, resource::hint &&hint) noexcept
+    {
+        if constexpr (std::is_polymorphic<T>::value)
+        {
+            static_assert(std::is_constructible<T, restore_t>::value,
+                          "Restored types with virtual functions need a restore constructor.");
+            object = new (object) T(restore_t{});
+        }
+
+        return this->build<T>(object, std::move(hint));
     }
 
     /**
@@ -108,7 +199,20 @@ public:
             }
 
             // No need to reclaim memory.
-            resource.get<T>()->~T();
+            if (const auto *replica_table = _allocator.replicas(resource.get<void>()); replica_table != nullptr)
+            {
+                for (auto *replica : replica_table->replicas)
+                {
+                    if (replica != nullptr)
+                    {
+                        static_cast<T *>(replica)->~T();
+                    }
+                }
+            }
+            else
+            {
+                resource.get<T>()->~T();
+            }
             _allocator.free(resource.get<void>());
         }
     }
@@ -121,7 +225,49 @@ private:
     tasking::Scheduler &_scheduler;
 
     // Next channel id for round-robin scheduling.
-    alignas(64) std::atomic_uint16_t _round_robin_channel_id{0U};
+    alignas(64) std::atomic_uint64_t _round_robin_channel_id{0U};
+
+    /**
+     * Builds a single data object of given type with given size and arguments.
+     *
+     * @param size Size of the data object.
+     * @param hint Hint for scheduling and synchronization.
+     * @param arguments Arguments to the constructor.
+     * @return Tagged pointer holding the synchronization, assigned channel and pointer.
+     */
+    template <typename T, typename... Args>
+    ptr build_object(const std::size_t size, const resource::hint &hint, Args &&... arguments) noexcept
+    {
+        const auto synchronization_method = Builder::isolation_level_to_synchronization_primitive(hint);
+
+        const auto [channel_id, numa_node_id] = schedule(hint);
+        const auto resource_information = information{channel_id, synchronization_method, hint};
+
+        if (hint.placement() == resource::hint::memory_placement::replicated)
+        {
+            // Every replica is constructed from the same arguments.
+            auto *object = _allocator.allocate_replicated(numa_node_id, 64U, size);
+            if (object == nullptr)
+            {
+                return ptr{nullptr, resource_information};
+            }
+
+            for (auto *replica : _allocator.replicas(object)->replicas)
+            {
+                if (replica != nullptr)
+                {
+                    Builder::initialize_synchronization(new (replica) T(arguments...), synchronization_method, hint);
+                }
+            }
+
+            return ptr{object, resource_information};
+        }
+
+        auto *object = new (allocate<T>(numa_node_id, size, hint.placement())) T(std::forward<Args>(arguments)...);
+        Builder::initialize_synchronization(object, synchronization_method, hint);
+
+        return ptr{object, resource_information};
+    }
 
     /**
      * Schedules the resource to a channel, affected by the given hint.
@@ -131,6 +277,62 @@ private:
      */
     std::pair<std::uint16_t, std::uint8_t> schedule(const resource::hint &hint);
 
+    /**
+     * Places a resource without a hinted channel: next to the affine channel,
+     * if any, or on the less loaded of the round robin channel and a partner.
+     *
+     * @param hint Hint for scheduling.
+     * @param ticket Round robin ticket of the resource.
+     * @param load Callable returning the load of a channel.
+     * @return Channel ID.
+     */
+    template <typename L> std::uint16_t place(const resource::hint &hint, std::uint64_t ticket, L &&load) const;
+
+    /**
+     * Schedules a set of resources to channels, affected by the given hint.
+     * Without a hinted channel, every resource is placed like a single one.
+     *
+     * @param hint Hint for scheduling.
+     * @param channels Pairs of Channel and NUMA node IDs, one for every resource.
+     */
+    void schedule(const resource::hint &hint, std::vector<std::pair<std::uint16_t, std::uint8_t>> &channels);
+
+    /**
+     * Allocates memory for a single resource.
+     *
+     * @param numa_node_id NUMA region of the resource.
+     * @param size Size of the resource.
+     * @param placement Placement of the memory over NUMA regions (local or interleaved).
+     * @return Allocated memory.
+     */
+    template <typename T>
+    void *allocate(const std::uint8_t numa_node_id, const std::size_t size,
+                   const resource::hint::memory_placement placement) noexcept
+    {
+        if (placement == resource::hint::memory_placement::interleaved)
+        {
+            return _allocator.allocate_interleaved(64U, size);
+        }
+
+        // Objects of the size of their type (rounded to the cache line) are allocated from the pool of the type.
+        if (size <= memory::alignment_helper::next_multiple(sizeof(T), std::size_t(64U)))
+        {
+            return _allocator.allocate<T>(numa_node_id, size);
+        }
+
+        return _allocator.allocate(numa_node_id, 64U, size);
+    }
+
+    /**
+     * Allocates memory for a set of resources; one allocation per NUMA region.
+     *
+     * @param channels Pairs of Channel and NUMA node IDs, one for every resource.
+     * @param size Size of every resource.
+     * @param objects Allocated memory, one for every resource.
+     */
+    void allocate(const std::vector<std::pair<std::uint16_t, std::uint8_t>> &channels, std::size_t size,
+                  std::vector<void *> &objects);
+
     /**
      * Determines the best synchronization method based on
      * synchronization requirement.
@@ -140,5 +342,35 @@ private:
      * @return Chosen synchronization method.
      */
     static synchronization::primitive isolation_level_to_synchronization_primitive(const hint &hint) noexcept;
+
+    /**
+     * Chooses the primitive an adaptively synchronized resource
+     * starts with, based on the hinted access pattern.
+     *
+     * @param hint Hint for synchronization.
+     * @return Initial primitive (OLFIT or ScheduleWriter).
+     */
+    static synchronization::primitive initial_adaptive_primitive(const hint &hint) noexcept;
+
+    /**
+     * Initializes the synchronization state of a freshly built resource.
+     *
+     * @param object Built resource.
+     * @param synchronization_method Primitive the resource is synchronized with.
+     * @param hint Hint for synchronization.
+     */
+    template <typename T>
+    static void initialize_synchronization(T *object, const synchronization::primitive synchronization_method,
+                                           const hint &hint) noexcept
+    {
+        if constexpr (std::is_base_of<ResourceInterface, T>::value)
+        {
+            object->initialize_synchronization(synchronization_method);
+            if (synchronization_method == synchronization::primitive::Adaptive)
+            {
+                object->adaptive_synchronization().reset(Builder::initial_adaptive_primitive(hint));
+            }
+        }
+    }
 };
 } // namespace mx::resource
\ No newline at end of file
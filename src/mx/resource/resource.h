@@ -6,14 +6,15 @@
 #include <mx/memory/alignment_helper.h>
 #include <mx/memory/tagged_ptr.h>
 #include <mx/synchronization/synchronization.h>
+#include <mx/system/cache.h>
 #include <mx/util/random.h>
 #include <new>
 
 namespace mx::resource {
 /**
  * Hint for creating resources by the resource interface.
- * Encapsulates the requested numa region, synchronization requirements
- * and expected access frequency.
+ * Encapsulates the requested numa region, synchronization requirements,
+ * expected access frequency, and how the resource should be prefetched.
  */
 class hint
 {
@@ -35,6 +36,37 @@ public:
         heavy_written = 4U
     };
 
+    enum memory_placement : std::uint8_t
+    {
+        local = 0U,       // On the NUMA region of the channel (or the hinted region).
+        interleaved = 1U, // Pages interleaved over all NUMA regions.
+        replicated = 2U   // One replica per NUMA region; for read-only resources.
+    };
+
+    /**
+     * Channel a resource should preferably be placed on, e.g., the channel
+     * of a related resource. In contrast to a channel hint, the affinity is
+     * soft: the resource is placed elsewhere when the channel is clearly
+     * more loaded than others.
+     */
+    class affinity
+    {
+    public:
+        constexpr affinity() noexcept = default;
+        constexpr explicit affinity(const std::uint16_t channel_id) noexcept : _channel_id(channel_id) {}
+        ~affinity() noexcept = default;
+
+        [[nodiscard]] constexpr bool has_channel_id() const noexcept
+        {
+            return _channel_id < std::numeric_limits<std::uint16_t>::max();
+        }
+        [[nodiscard]] constexpr std::uint16_t channel_id() const noexcept { return _channel_id; }
+
+    private:
+        // Affine channel; no affinity by default.
+        std::uint16_t _channel_id{std::numeric_limits<std::uint16_t>::max()};
+    };
+
     constexpr explicit hint(const std::uint8_t node_id) noexcept : _numa_node_id(node_id) {}
     constexpr explicit hint(const std::uint16_t channel_id) noexcept : _channel_id(channel_id) {}
     constexpr explicit hint(const synchronization::isolation_level isolation_level) noexcept
@@ -45,6 +77,16 @@ public:
         : _access_frequency(access_frequency)
     {
     }
+    constexpr explicit hint(const memory_placement placement) noexcept : _placement(placement) {}
+    constexpr hint(const synchronization::isolation_level isolation_level, const memory_placement placement) noexcept
+        : _isolation_level(isolation_level), _placement(placement)
+    {
+    }
+    constexpr hint(const synchronization::isolation_level isolation_level,
+                   const expected_access_frequency access_frequency, const memory_placement placement) noexcept
+        : _access_frequency(access_frequency), _isolation_level(isolation_level), _placement(placement)
+    {
+    }
     constexpr hint(const std::uint16_t channel_id, const synchronization::isolation_level isolation_level) noexcept
         : _channel_id(channel_id), _isolation_level(isolation_level)
     {
@@ -88,6 +130,30 @@ public:
           _preferred_protocol(preferred_protocol)
     {
     }
+    constexpr hint(const synchronization::isolation_level isolation_level,
+                   const synchronization::protocol preferred_protocol, const expected_access_frequency access_frequency,
+                   const expected_read_write_ratio read_write_ratio, const system::cache::level prefetch_level) noexcept
+        : _access_frequency(access_frequency), _read_write_ratio(read_write_ratio), _isolation_level(isolation_level),
+          _preferred_protocol(preferred_protocol), _prefetch_level(prefetch_level)
+    {
+    }
+    constexpr hint(const synchronization::isolation_level isolation_level,
+                   const synchronization::protocol preferred_protocol, const expected_access_frequency access_frequency,
+                   const expected_read_write_ratio read_write_ratio, const system::cache::level prefetch_level,
+                   const system::cache::access prefetch_access) noexcept
+        : _access_frequency(access_frequency), _read_write_ratio(read_write_ratio), _isolation_level(isolation_level),
+          _preferred_protocol(preferred_protocol), _prefetch_level(prefetch_level), _prefetch_access(prefetch_access)
+    {
+    }
+    constexpr hint(const synchronization::isolation_level isolation_level,
+                   const synchronization::protocol preferred_protocol, const expected_access_frequency access_frequency,
+                   const expected_read_write_ratio read_write_ratio, const system::cache::level prefetch_level,
+                   const affinity channel_affinity) noexcept
+        : _affinity_channel_id(channel_affinity.channel_id()), _access_frequency(access_frequency),
+          _read_write_ratio(read_write_ratio), _isolation_level(isolation_level),
+          _preferred_protocol(preferred_protocol), _prefetch_level(prefetch_level)
+    {
+    }
     constexpr hint(const std::uint8_t node_id, const synchronization::isolation_level isolation_level,
                    const expected_access_frequency access_frequency) noexcept
         : _numa_node_id(node_id), _access_frequency(access_frequency), _isolation_level(isolation_level)
@@ -116,10 +182,20 @@ public:
         return _channel_id < std::numeric_limits<std::uint16_t>::max();
     }
     [[nodiscard]] std::uint16_t channel_id() const noexcept { return _channel_id; }
+
+    [[nodiscard]] bool has_affinity_channel_id() const noexcept
+    {
+        return _affinity_channel_id < std::numeric_limits<std::uint16_t>::max();
+    }
+    [[nodiscard]] std::uint16_t affinity_channel_id() const noexcept { return _affinity_channel_id; }
     [[nodiscard]] expected_access_frequency access_frequency() const noexcept { return _access_frequency; }
     [[nodiscard]] expected_read_write_ratio read_write_ratio() const noexcept { return _read_write_ratio; }
     [[nodiscard]] synchronization::isolation_level isolation_level() const noexcept { return _isolation_level; }
     [[nodiscard]] synchronization::protocol preferred_protocol() const noexcept { return _preferred_protocol; }
+    [[nodiscard]] bool has_prefetch_level() const noexcept { return _prefetch_level != 0U; }
+    [[nodiscard]] std::uint8_t prefetch_level() const noexcept { return _prefetch_level; }
+    [[nodiscard]] system::cache::access prefetch_access() const noexcept { return _prefetch_access; }
+    [[nodiscard]] memory_placement placement() const noexcept { return _placement; }
 
     bool operator==(const synchronization::isolation_level isolation_level) const noexcept
     {
@@ -144,6 +220,9 @@ private:
     // Preferred channel; no preference by default.
     const std::uint16_t _channel_id{std::numeric_limits<std::uint16_t>::max()};
 
+    // Channel the resource should preferably be placed on; no affinity by default.
+    const std::uint16_t _affinity_channel_id{std::numeric_limits<std::uint16_t>::max()};
+
     // Expected access frequency; normal by default.
     const enum expected_access_frequency _access_frequency { expected_access_frequency::normal };
 
@@ -155,19 +234,43 @@ private:
 
     // Preferred synchronization protocol (queue, latch, ...); no synchronization by default.
     const synchronization::protocol _preferred_protocol{synchronization::protocol::None};
+
+    // Cache level the resource is prefetched to; chosen by the runtime by default.
+    const std::uint8_t _prefetch_level{0U};
+
+    // Access the resource is prefetched for; read by default, which means that
+    // only writing tasks prefetch the resource for write access.
+    const system::cache::access _prefetch_access{system::cache::access::read};
+
+    // Placement of the memory over NUMA regions; on a single region by default.
+    const memory_placement _placement{memory_placement::local};
 };
 
 /**
  * Information of a resource, stored within
- * the pointer to the resource.
+ * the pointer to the resource. The 16 bits
+ * hold the channel id (9 bits, thus, at most
+ * 512 channels), the synchronization primitive
+ * (4 bits), and the prefetch hints (3 bits).
  */
 class information
 {
 public:
-    constexpr information() noexcept : _channel_id(0U), _synchronization_primitive(0U) { }
+    constexpr information() noexcept
+        : _channel_id(0U), _synchronization_primitive(0U), _prefetch_level(0U), _prefetch_for_write(0U)
+    {
+    }
     explicit information(const std::uint16_t channel_id,
                          const synchronization::primitive synchronization_primitive) noexcept
-        : _channel_id(channel_id), _synchronization_primitive(static_cast<std::uint16_t>(synchronization_primitive))
+        : _channel_id(channel_id), _synchronization_primitive(static_cast<std::uint16_t>(synchronization_primitive)),
+          _prefetch_level(0U), _prefetch_for_write(0U)
+    {
+    }
+    information(const std::uint16_t channel_id, const synchronization::primitive synchronization_primitive,
+                const hint &hint) noexcept
+        : _channel_id(channel_id), _synchronization_primitive(static_cast<std::uint16_t>(synchronization_primitive)),
+          _prefetch_level(hint.prefetch_level()),
+          _prefetch_for_write(hint.prefetch_access() == system::cache::access::write)
     {
     }
 
@@ -178,12 +281,21 @@ public:
     {
         return static_cast<synchronization::primitive>(_synchronization_primitive);
     }
+    [[nodiscard]] bool has_prefetch_level() const noexcept { return _prefetch_level != 0U; }
+    [[nodiscard]] system::cache::level prefetch_level() const noexcept
+    {
+        return static_cast<system::cache::level>(_prefetch_level);
+    }
+    [[nodiscard]] bool is_prefetched_for_write() const noexcept { return _prefetch_for_write; }
 
     information &operator=(const information &other) = default;
 
 private:
-    std::uint16_t _channel_id : 12;
+    // Channel the resource is mapped to; limited to 512 channels (see config::max_cores()).
+    std::uint16_t _channel_id : 9;
     std::uint16_t _synchronization_primitive : 4;
+    std::uint16_t _prefetch_level : 2;
+    std::uint16_t _prefetch_for_write : 1;
 } __attribute__((packed));
 
 /**
@@ -206,6 +318,9 @@ public:
     {
         return info().synchronization_primitive();
     }
+    [[nodiscard]] bool has_prefetch_level() const noexcept { return info().has_prefetch_level(); }
+    [[nodiscard]] system::cache::level prefetch_level() const noexcept { return info().prefetch_level(); }
+    [[nodiscard]] bool is_prefetched_for_write() const noexcept { return info().is_prefetched_for_write(); }
 } __attribute__((packed));
 
 /**
@@ -3,31 +3,57 @@
 #include <atomic>
 #include <cstdint>
 #include <mx/memory/reclamation/epoch_t.h>
+#include <mx/synchronization/adaptive_synchronization.h>
+#include <mx/synchronization/cohort_lock.h>
+#include <mx/synchronization/mcs_lock.h>
 #include <mx/synchronization/optimistic_lock.h>
-#include <mx/synchronization/rw_spinlock.h>
+#include <mx/synchronization/biased_rw_spinlock.h>
 #include <mx/synchronization/spinlock.h>
+#include <new>
 
 namespace mx::resource {
+/**
+ * Tag of constructors restoring a resource from a persistent heap after a
+ * restart (see runtime::restore_resource()). Such a constructor rebuilds the
+ * pointer to the virtual table, which is stale in a new process, and has to
+ * keep the members of the resource: it must not initialize them, neither by
+ * its initializer list nor by default member initializers.
+ */
+struct restore_t
+{
+    explicit restore_t() = default;
+};
+
 /**
  * The resource interface represents resources that
  * needs to be synchronized by the tasking engine.
  * Supported synchronizations are:
- *  - Latches (Spinlock, R/W-lock)
+ *  - Latches (Spinlock, reader-biased R/W-lock, MCS-lock, NUMA cohort-lock)
  *  - Optimistic latches + memory reclamation
+ * Every resource is synchronized by a single primitive (stored in the
+ * resource pointer); therefore, only the state of that primitive is kept.
  */
 class ResourceInterface
 {
+    friend class ResourceSetLatch;
+
 public:
     enum SynchronizationType : std::uint8_t
     {
         Exclusive,
-        SharedRead,
         SharedWrite,
         Optimistic,
         OLFIT,
     };
 
     constexpr ResourceInterface() noexcept = default;
+
+    /**
+     * Restores the resource from a persistent heap. Since latches may still be
+     * held by tasks of the previous run, the synchronization state is reset.
+     */
+    explicit ResourceInterface(restore_t /*restore*/) noexcept {}
+
     ResourceInterface(const ResourceInterface &) = delete;
     ResourceInterface(ResourceInterface &&) = delete;
     virtual ~ResourceInterface() = default;
@@ -41,19 +67,19 @@ public:
      * Set the next resource in garbage list.
      * @param next Next resource in garbage list.
      */
-    void next(ResourceInterface *next) noexcept { _next_garbage = next; }
+    void next(ResourceInterface *next) noexcept { _synchronization.optimistic.next_garbage = next; }
 
     /**
      * @return Next resource in garbage list.
      */
-    [[nodiscard]] ResourceInterface *next() const noexcept { return _next_garbage; }
+    [[nodiscard]] ResourceInterface *next() const noexcept { return _synchronization.optimistic.next_garbage; }
 
     /**
      * @return The current version of the resource.
      */
     [[nodiscard]] synchronization::OptimisticLock::version_t version() const noexcept
     {
-        return _optimistic_latch.read_valid();
+        return _synchronization.optimistic.latch.read_valid();
     }
 
     /**
@@ -64,25 +90,86 @@ public:
      */
     [[nodiscard]] bool is_version_valid(const synchronization::OptimisticLock::version_t version) const noexcept
     {
-        return _optimistic_latch.is_valid(version);
+        return _synchronization.optimistic.latch.is_valid(version);
     }
 
     /**
      * Tries to acquire the optimistic latch.
      * @return True, when latch was acquired.
      */
-    [[nodiscard]] bool try_acquire_optimistic_latch() noexcept { return _optimistic_latch.try_lock(); }
+    [[nodiscard]] bool try_acquire_optimistic_latch() noexcept { return _synchronization.optimistic.latch.try_lock(); }
+
+    /**
+     * Acquires the optimistic latch for a writer that may run on any channel.
+     * @return Number of failed tries to acquire the latch.
+     */
+    std::uint32_t acquire_optimistic_latch() noexcept { return _synchronization.optimistic.latch.lock<false>(); }
+
+    /**
+     * Releases the optimistic latch.
+     */
+    void release_optimistic_latch() noexcept { _synchronization.optimistic.latch.unlock(); }
+
+    /**
+     * @return State of the adaptive synchronization, used when synchronized by primitive::Adaptive.
+     */
+    [[nodiscard]] synchronization::AdaptiveSynchronization &adaptive_synchronization() noexcept
+    {
+        return _synchronization.optimistic.adaptive_synchronization;
+    }
+
+    /**
+     * @return State of the adaptive synchronization, used when synchronized by primitive::Adaptive.
+     */
+    [[nodiscard]] const synchronization::AdaptiveSynchronization &adaptive_synchronization() const noexcept
+    {
+        return _synchronization.optimistic.adaptive_synchronization;
+    }
+
+    /**
+     * Initializes the state of the primitive the resource is synchronized with.
+     * Resources are constructed with the state of optimistic primitives.
+     *
+     * @param primitive_ Primitive the resource is synchronized with.
+     */
+    void initialize_synchronization(const synchronization::primitive primitive_) noexcept
+    {
+        switch (primitive_)
+        {
+        case synchronization::primitive::ExclusiveLatch:
+            new (&_synchronization.exclusive_latch) synchronization::Spinlock();
+            break;
+        case synchronization::primitive::ReaderWriterLatch:
+            new (&_synchronization.rw_latch) synchronization::BiasedRWSpinLock();
+            break;
+        case synchronization::primitive::MCSLatch:
+            new (&_synchronization.mcs_latch) synchronization::MCSLock();
+            break;
+        case synchronization::primitive::CohortLatch:
+            new (&_synchronization.cohort_latch) synchronization::CohortLock();
+            break;
+        default:
+            break;
+        }
+    }
+
 
     /**
      * Set the epoch-timestamp this resource was removed.
      * @param epoch Epoch where this resource was removed.
      */
-    void remove_epoch(const memory::reclamation::epoch_t epoch) noexcept { _remove_epoch = epoch; }
+    void remove_epoch(const memory::reclamation::epoch_t epoch) noexcept
+    {
+        _synchronization.optimistic.remove_epoch = epoch;
+    }
 
     /**
      * @return The epoch this resource was removed.
      */
-    [[nodiscard]] memory::reclamation::epoch_t remove_epoch() const noexcept { return _remove_epoch; }
+    [[nodiscard]] memory::reclamation::epoch_t remove_epoch() const noexcept
+    {
+        return _synchronization.optimistic.remove_epoch;
+    }
 
     template <SynchronizationType T> class scoped_latch
     {
@@ -91,23 +178,19 @@ public:
         {
             if constexpr (T == SynchronizationType::Exclusive)
             {
-                _resource->_exclusive_latch.lock();
-            }
-            else if constexpr (T == SynchronizationType::SharedRead)
-            {
-                _resource->_rw_latch.lock_shared();
+                _resource->_synchronization.exclusive_latch.lock();
             }
             else if constexpr (T == SynchronizationType::SharedWrite)
             {
-                _resource->_rw_latch.lock();
+                _resource->_synchronization.rw_latch.lock();
             }
             else if constexpr (T == SynchronizationType::Optimistic)
             {
-                _resource->_optimistic_latch.lock<true>();
+                _resource->_synchronization.optimistic.latch.lock<true>();
             }
             else if constexpr (T == SynchronizationType::OLFIT)
             {
-                _resource->_optimistic_latch.lock<false>();
+                _resource->_synchronization.optimistic.latch.lock<false>();
             }
         }
 
@@ -115,19 +198,15 @@ public:
         {
             if constexpr (T == SynchronizationType::Exclusive)
             {
-                _resource->_exclusive_latch.unlock();
-            }
-            else if constexpr (T == SynchronizationType::SharedRead)
-            {
-                _resource->_rw_latch.unlock_shared();
+                _resource->_synchronization.exclusive_latch.unlock();
             }
             else if constexpr (T == SynchronizationType::SharedWrite)
             {
-                _resource->_rw_latch.unlock();
+                _resource->_synchronization.rw_latch.unlock();
             }
             else if constexpr (T == SynchronizationType::Optimistic || T == SynchronizationType::OLFIT)
             {
-                _resource->_optimistic_latch.unlock();
+                _resource->_synchronization.optimistic.latch.unlock();
             }
         }
 
@@ -135,20 +214,112 @@ public:
         ResourceInterface *_resource;
     };
 
+    /**
+     * Holds the reader/writer latch of a resource for reading while in scope.
+     * As long as the latch is biased towards readers, the reader is only
+     * published in the slot of the given channel.
+     */
+    class scoped_reader_latch
+    {
+    public:
+        inline scoped_reader_latch(ResourceInterface *resource, const std::uint16_t channel_id) noexcept
+            : _resource(resource), _channel_id(channel_id),
+              _is_visible_reader(resource->_synchronization.rw_latch.lock_shared(channel_id))
+        {
+        }
+
+        inline ~scoped_reader_latch() noexcept
+        {
+            _resource->_synchronization.rw_latch.unlock_shared(_channel_id, _is_visible_reader);
+        }
+
+    private:
+        ResourceInterface *_resource;
+        const std::uint16_t _channel_id;
+        const bool _is_visible_reader;
+    };
+
+    /**
+     * Holds the queue-based (MCS) latch of a resource while in scope.
+     * The queue node of the caller lives within the scope.
+     */
+    class scoped_mcs_latch
+    {
+    public:
+        inline explicit scoped_mcs_latch(ResourceInterface *resource) noexcept : _resource(resource)
+        {
+            _resource->_synchronization.mcs_latch.lock(_queue_node);
+        }
+
+        inline ~scoped_mcs_latch() noexcept { _resource->_synchronization.mcs_latch.unlock(_queue_node); }
+
+    private:
+        ResourceInterface *_resource;
+        synchronization::MCSLock::QueueNode _queue_node;
+    };
+
+    /**
+     * Holds the NUMA-aware cohort latch of a resource while in scope.
+     * The queue node of the caller lives within the scope.
+     */
+    class scoped_cohort_latch
+    {
+    public:
+        inline scoped_cohort_latch(ResourceInterface *resource, const std::uint8_t numa_node_id) noexcept
+            : _resource(resource), _numa_node_id(numa_node_id)
+        {
+            _resource->_synchronization.cohort_latch.lock(_queue_node, _numa_node_id);
+        }
+
+        inline ~scoped_cohort_latch() noexcept
+        {
+            _resource->_synchronization.cohort_latch.unlock(_queue_node, _numa_node_id);
+        }
+
+    private:
+        ResourceInterface *_resource;
+        const std::uint8_t _numa_node_id;
+        synchronization::CohortLock::QueueNode _queue_node;
+    };
+
     using scoped_exclusive_latch = scoped_latch<SynchronizationType::Exclusive>;
     using scoped_optimistic_latch = scoped_latch<SynchronizationType::Optimistic>;
     using scoped_olfit_latch = scoped_latch<SynchronizationType::OLFIT>;
-    template <bool WRITER>
-    using scoped_rw_latch = scoped_latch<WRITER ? SynchronizationType::SharedWrite : SynchronizationType::SharedRead>;
+    using scoped_writer_latch = scoped_latch<SynchronizationType::SharedWrite>;
 
 private:
-    // Encapsulated synchronization primitives.
-    synchronization::Spinlock _exclusive_latch;
-    synchronization::RWSpinLock _rw_latch;
-    synchronization::OptimisticLock _optimistic_latch;
+    /**
+     * State of optimistically synchronized resources (ScheduleWriter, OLFIT, and Adaptive).
+     */
+    struct OptimisticState
+    {
+        synchronization::OptimisticLock latch;
+
+        // Epoch and Garbage management.
+        memory::reclamation::epoch_t remove_epoch{0U};
+        ResourceInterface *next_garbage{nullptr};
+
+        // Only used by primitive::Adaptive.
+        synchronization::AdaptiveSynchronization adaptive_synchronization;
+    };
 
-    // Epoch and Garbage management.
-    memory::reclamation::epoch_t _remove_epoch{0U};
-    ResourceInterface *_next_garbage{nullptr};
+    /**
+     * State of the primitive the resource is synchronized with. Latched
+     * resources are never reclaimed by the epoch manager, thus, they do
+     * not need the garbage state.
+     */
+    union SynchronizationState {
+        constexpr SynchronizationState() noexcept : optimistic() {}
+        ~SynchronizationState() noexcept = default;
+
+        OptimisticState optimistic;
+        synchronization::Spinlock exclusive_latch;
+        synchronization::BiasedRWSpinLock rw_latch;
+        synchronization::MCSLock mcs_latch;
+        synchronization::CohortLock cohort_latch;
+    };
+
+    // Encapsulated synchronization primitives.
+    SynchronizationState _synchronization;
 };
 } // namespace mx::resource
\ No newline at end of file
@@ -0,0 +1,211 @@
+#pragma once
+
+#include "resource.h"
+#include "resource_interface.h"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <mx/synchronization/cohort_lock.h>
+#include <mx/synchronization/mcs_lock.h>
+#include <mx/synchronization/optimistic_lock.h>
+#include <mx/tasking/config.h>
+
+namespace mx::resource {
+/**
+ * Acquires a set of resources, each using its own synchronization primitive.
+ * To avoid deadlocks between tasks holding several resources, the resources
+ * are acquired in a global order (the address of the resource) and released
+ * in reverse order. Optimistically synchronized resources are not latched by
+ * reading tasks; instead, their versions are recorded and have to be validated
+ * after execution.
+ * Resources synchronized by scheduling (ScheduleAll and ScheduleWriter for
+ * writers) are not latched; the runtime routes the task to their channel.
+ */
+class ResourceSetLatch
+{
+public:
+    /**
+     * @param resources Resources to acquire.
+     * @param count Number of resources.
+     * @param is_readonly True, when the resources are only read.
+     * @param channel_id Channel the acquiring task is executed on.
+     * @param numa_node_id NUMA region of the channel.
+     */
+    ResourceSetLatch(const ptr *resources, const std::uint16_t count, const bool is_readonly,
+                     const std::uint16_t channel_id, const std::uint8_t numa_node_id) noexcept
+        : _is_readonly(is_readonly), _channel_id(channel_id), _numa_node_id(numa_node_id)
+    {
+        assert(count <= tasking::config::max_annotated_resources() && "Too many resources annotated.");
+
+        std::copy(resources, resources + count, _resources.begin());
+        std::sort(_resources.begin(), _resources.begin() + count,
+                  [](const ptr left, const ptr right) { return left.get() < right.get(); });
+
+        // Every resource is acquired once, even if annotated multiple times.
+        _count = std::distance(_resources.begin(),
+                               std::unique(_resources.begin(), _resources.begin() + count,
+                                           [](const ptr left, const ptr right) { return left.get() == right.get(); }));
+    }
+
+    ~ResourceSetLatch() noexcept = default;
+
+    /**
+     * Acquires all resources in address order.
+     */
+    void lock() noexcept
+    {
+        for (auto i = 0U; i < _count; ++i)
+        {
+            auto *resource = _resources[i].get<ResourceInterface>();
+            switch (_resources[i].synchronization_primitive())
+            {
+            case synchronization::primitive::ExclusiveLatch:
+                resource->_synchronization.exclusive_latch.lock();
+                break;
+            case synchronization::primitive::MCSLatch:
+                resource->_synchronization.mcs_latch.lock(_mcs_queue_nodes[i]);
+                break;
+            case synchronization::primitive::CohortLatch:
+                resource->_synchronization.cohort_latch.lock(_cohort_queue_nodes[i], _numa_node_id);
+                break;
+            case synchronization::primitive::ReaderWriterLatch:
+                if (_is_readonly && _count == 1U)
+                {
+                    _is_visible_reader[i] = resource->_synchronization.rw_latch.lock_shared(_channel_id);
+                }
+                else if (_is_readonly)
+                {
+                    // The channel has a single slot in the table of visible readers;
+                    // holding several latches, readers use the (counted) latch.
+                    resource->_synchronization.rw_latch.lock_shared();
+                    _is_visible_reader[i] = false;
+                }
+                else
+                {
+                    resource->_synchronization.rw_latch.lock();
+                }
+                break;
+            case synchronization::primitive::ScheduleWriter:
+                if (_is_readonly)
+                {
+                    _versions[i] = resource->version();
+                }
+                else
+                {
+                    resource->_synchronization.optimistic.latch.lock<true>();
+                }
+                break;
+            case synchronization::primitive::OLFIT:
+            case synchronization::primitive::Adaptive:
+                if (_is_readonly)
+                {
+                    _versions[i] = resource->version();
+                }
+                else
+                {
+                    resource->_synchronization.optimistic.latch.lock<false>();
+                }
+                break;
+            case synchronization::primitive::ScheduleAll:
+            case synchronization::primitive::None:
+                break;
+            }
+        }
+    }
+
+    /**
+     * Validates the versions of all optimistically read resources.
+     *
+     * @return True, when no optimistically read resource was modified since lock().
+     */
+    [[nodiscard]] bool is_valid() const noexcept
+    {
+        if (_is_readonly == false)
+        {
+            return true;
+        }
+
+        for (auto i = 0U; i < _count; ++i)
+        {
+            if (synchronization::is_optimistic(_resources[i].synchronization_primitive()) &&
+                _resources[i].get<ResourceInterface>()->is_version_valid(_versions[i]) == false)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * Releases all resources in reverse order.
+     */
+    void unlock() noexcept
+    {
+        for (auto i = _count; i > 0U; --i)
+        {
+            const auto index = i - 1U;
+            auto *resource = _resources[index].get<ResourceInterface>();
+            switch (_resources[index].synchronization_primitive())
+            {
+            case synchronization::primitive::ExclusiveLatch:
+                resource->_synchronization.exclusive_latch.unlock();
+                break;
+            case synchronization::primitive::MCSLatch:
+                resource->_synchronization.mcs_latch.unlock(_mcs_queue_nodes[index]);
+                break;
+            case synchronization::primitive::CohortLatch:
+                resource->_synchronization.cohort_latch.unlock(_cohort_queue_nodes[index], _numa_node_id);
+                break;
+            case synchronization::primitive::ReaderWriterLatch:
+                if (_is_readonly)
+                {
+                    resource->_synchronization.rw_latch.unlock_shared(_channel_id, _is_visible_reader[index]);
+                }
+                else
+                {
+                    resource->_synchronization.rw_latch.unlock();
+                }
+                break;
+            case synchronization::primitive::ScheduleWriter:
+            case synchronization::primitive::OLFIT:
+            case synchronization::primitive::Adaptive:
+                if (_is_readonly == false)
+                {
+                    resource->_synchronization.optimistic.latch.unlock();
+                }
+                break;
+            case synchronization::primitive::ScheduleAll:
+            case synchronization::primitive::None:
+                break;
+            }
+        }
+    }
+
+private:
+    // Resources, ordered by address.
+    std::array<ptr, tasking::config::max_annotated_resources()> _resources{};
+
+    // Number of (distinct) resources.
+    std::uint16_t _count;
+
+    // Are the resources only read?
+    const bool _is_readonly;
+
+    // Channel and NUMA region of the acquiring task.
+    const std::uint16_t _channel_id;
+    const std::uint8_t _numa_node_id;
+
+    // Versions of optimistically read resources.
+    std::array<synchronization::OptimisticLock::version_t, tasking::config::max_annotated_resources()> _versions{};
+
+    // Did readers of reader/writer latched resources publish themselves in the visible readers table?
+    std::array<bool, tasking::config::max_annotated_resources()> _is_visible_reader{};
+
+    // Queue nodes for queue-based latched resources.
+    std::array<synchronization::MCSLock::QueueNode, tasking::config::max_annotated_resources()> _mcs_queue_nodes{};
+    std::array<synchronization::CohortLock::QueueNode, tasking::config::max_annotated_resources()>
+        _cohort_queue_nodes{};
+};
+} // namespace mx::resource
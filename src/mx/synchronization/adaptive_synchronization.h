@@ -0,0 +1,170 @@
+#pragma once
+
+#include "synchronization.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mx/tasking/config.h>
+
+namespace mx::synchronization {
+/**
+ * State of a resource synchronized by primitive::Adaptive. The resource
+ * is either synchronized like OLFIT (writers execute anywhere) or like
+ * ScheduleWriter (writers are scheduled to the channel of the resource).
+ * Since readers always validate the version and writers always acquire
+ * the version by compare-exchange, both modes can be mixed safely: switching
+ * only changes where future writers are executed, while writers in flight
+ * stay correct wherever they execute.
+ *
+ * The decision is based on sampled accesses of the resource: reads and
+ * writes, the aborts of sampled optimistic reads, and the spins of sampled
+ * writers waiting for the latch. When conflicts (aborts and spins) spike,
+ * writers are serialized on the channel of the resource; once conflicts
+ * are rare, writers may execute anywhere again.
+ */
+class AdaptiveSynchronization
+{
+public:
+    constexpr AdaptiveSynchronization() noexcept = default;
+    ~AdaptiveSynchronization() noexcept = default;
+
+    /**
+     * @return The primitive the resource is currently synchronized with (OLFIT or ScheduleWriter).
+     */
+    [[nodiscard]] primitive current() const noexcept { return _primitive.load(std::memory_order_relaxed); }
+
+    /**
+     * Resets the synchronization to the given primitive.
+     *
+     * @param primitive_ Primitive to start with (OLFIT or ScheduleWriter).
+     */
+    void reset(const primitive primitive_) noexcept
+    {
+        _primitive.store(primitive_ == primitive::ScheduleWriter ? primitive::ScheduleWriter : primitive::OLFIT,
+                         std::memory_order_relaxed);
+        _sampled_accesses.store(0U, std::memory_order_relaxed);
+        _sampled_writes.store(0U, std::memory_order_relaxed);
+        _aborts.store(0U, std::memory_order_relaxed);
+        _spins.store(0U, std::memory_order_relaxed);
+    }
+
+    /**
+     * Records a sampled read. When the sample window is complete,
+     * the primitive may be switched.
+     *
+     * @param aborts Number of times the optimistic read was aborted.
+     * @return True, when the primitive was switched.
+     */
+    bool sample_read(const std::uint32_t aborts) noexcept
+    {
+        if (aborts > 0U)
+        {
+            _aborts.fetch_add(AdaptiveSynchronization::clamp(aborts), std::memory_order_relaxed);
+        }
+
+        return this->sample();
+    }
+
+    /**
+     * Records a sampled write. When the sample window is complete,
+     * the primitive may be switched.
+     *
+     * @param spins Number of failed tries to acquire the latch.
+     * @return True, when the primitive was switched.
+     */
+    bool sample_write(const std::uint32_t spins) noexcept
+    {
+        if (spins > 0U)
+        {
+            _spins.fetch_add(AdaptiveSynchronization::clamp(spins), std::memory_order_relaxed);
+        }
+        _sampled_writes.fetch_add(1U, std::memory_order_relaxed);
+
+        return this->sample();
+    }
+
+    /**
+     * @return Number of sampled reads within the current window.
+     */
+    [[nodiscard]] std::uint16_t sampled_reads() const noexcept
+    {
+        return std::uint16_t(_sampled_accesses.load(std::memory_order_relaxed) - this->sampled_writes());
+    }
+
+    /**
+     * @return Number of sampled writes within the current window.
+     */
+    [[nodiscard]] std::uint16_t sampled_writes() const noexcept
+    {
+        return _sampled_writes.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Primitive the resource is currently synchronized with.
+    std::atomic<primitive> _primitive{primitive::OLFIT};
+
+    // Number of sampled accesses (reads and writes) within the current window.
+    std::atomic_uint8_t _sampled_accesses{0U};
+
+    // Number of sampled writes within the current window.
+    std::atomic_uint8_t _sampled_writes{0U};
+
+    // Aborts of sampled reads within the current window.
+    std::atomic_uint16_t _aborts{0U};
+
+    // Spins of sampled writes within the current window.
+    std::atomic_uint16_t _spins{0U};
+
+    static_assert(tasking::config::adaptive_synchronization_window() <= 255U,
+                  "Sampled accesses are counted with 8 bits.");
+
+    /**
+     * Limits the aborts or spins of a single access, so that
+     * the counters of a window do not overflow.
+     *
+     * @param count Aborts or spins of an access.
+     * @return Limited count.
+     */
+    [[nodiscard]] static std::uint16_t clamp(const std::uint32_t count) noexcept
+    {
+        return std::uint16_t(std::min(count, 255U));
+    }
+
+    /**
+     * Counts a sampled access; the last access of a window decides
+     * whether the primitive is switched.
+     *
+     * @return True, when the primitive was switched.
+     */
+    bool sample() noexcept
+    {
+        const auto sampled_accesses = _sampled_accesses.fetch_add(1U, std::memory_order_relaxed) + 1U;
+        if (sampled_accesses != tasking::config::adaptive_synchronization_window())
+        {
+            return false;
+        }
+
+        const auto sampled_writes = _sampled_writes.exchange(0U, std::memory_order_relaxed);
+        const auto conflicts = std::uint64_t{_aborts.exchange(0U, std::memory_order_relaxed)} +
+                               _spins.exchange(0U, std::memory_order_relaxed);
+        const auto conflicts_percent = (conflicts * 100U) / sampled_accesses;
+        _sampled_accesses.store(0U, std::memory_order_relaxed);
+
+        // Scheduling writers is only worth it, when writers were sampled at all.
+        auto current = this->current();
+        if (current == primitive::OLFIT && sampled_writes > 0U &&
+            conflicts_percent >= tasking::config::adaptive_synchronization_schedule_threshold())
+        {
+            return _primitive.compare_exchange_strong(current, primitive::ScheduleWriter, std::memory_order_relaxed);
+        }
+
+        if (current == primitive::ScheduleWriter &&
+            conflicts_percent < tasking::config::adaptive_synchronization_olfit_threshold())
+        {
+            return _primitive.compare_exchange_strong(current, primitive::OLFIT, std::memory_order_relaxed);
+        }
+
+        return false;
+    }
+};
+} // namespace mx::synchronization
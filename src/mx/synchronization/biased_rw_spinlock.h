@@ -0,0 +1,143 @@
+#pragma once
+
+#include "rw_spinlock.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mx/system/builtin.h>
+#include <mx/tasking/config.h>
+#include <mx/util/aligned_t.h>
+
+namespace mx::synchronization {
+/**
+ * Reader/writer latch with reader bias (BRAVO, Dice and Kogan), layered
+ * over the RWSpinLock. As long as the latch is biased towards readers,
+ * readers do not touch the shared lock word but publish the latch in
+ * their channel's slot of a global table of visible readers. Since every
+ * channel executes one task at a time, one (cache line aligned) slot per
+ * channel is sufficient and readers only write to their local line.
+ * Writers revoke the bias and wait until no slot publishes the latch.
+ * Revoking is expensive; therefore, the bias is inhibited for a multiple
+ * of the time spent for revocation, before slow readers re-enable it.
+ */
+class BiasedRWSpinLock
+{
+public:
+    constexpr BiasedRWSpinLock() noexcept = default;
+
+    BiasedRWSpinLock(BiasedRWSpinLock const &) = delete;
+    BiasedRWSpinLock &operator=(BiasedRWSpinLock const &) = delete;
+
+    /**
+     * Acquires the latch for reading.
+     *
+     * @param channel_id Channel of the reader.
+     * @return True, when the reader was published in the visible readers table.
+     *         Has to be passed to unlock_shared().
+     */
+    bool lock_shared(const std::uint16_t channel_id) noexcept
+    {
+        if (_is_reader_biased.load(std::memory_order_acquire))
+        {
+            auto &slot = _visible_readers[channel_id].value();
+            slot.store(this, std::memory_order_seq_cst);
+            if (_is_reader_biased.load(std::memory_order_seq_cst))
+            {
+                return true;
+            }
+
+            // A writer revoked the bias meanwhile.
+            slot.store(nullptr, std::memory_order_release);
+        }
+
+        this->lock_shared();
+        return false;
+    }
+
+    /**
+     * Acquires the latch for reading without publishing the reader in
+     * the visible readers table. Since a channel has a single slot, this
+     * is needed when the channel holds several latches for reading at a time.
+     * Has to be released by unlock_shared() with is_visible_reader = false.
+     */
+    void lock_shared() noexcept
+    {
+        _rw_latch.lock_shared();
+
+        // Re-enable the bias once the inhibition time is over; no writer
+        // can revoke the bias while we are holding the latch.
+        if (_is_reader_biased.load(std::memory_order_relaxed) == false &&
+            system::builtin::rdtsc() >= _inhibit_until)
+        {
+            _is_reader_biased.store(true, std::memory_order_release);
+        }
+    }
+
+    /**
+     * Releases the latch acquired for reading.
+     *
+     * @param channel_id Channel of the reader.
+     * @param is_visible_reader Result of lock_shared().
+     */
+    void unlock_shared(const std::uint16_t channel_id, const bool is_visible_reader) noexcept
+    {
+        if (is_visible_reader)
+        {
+            _visible_readers[channel_id].value().store(nullptr, std::memory_order_release);
+        }
+        else
+        {
+            _rw_latch.unlock_shared();
+        }
+    }
+
+    /**
+     * Acquires the latch for writing, revoking the reader bias if needed.
+     */
+    void lock() noexcept
+    {
+        _rw_latch.lock();
+
+        if (_is_reader_biased.load(std::memory_order_relaxed))
+        {
+            _is_reader_biased.store(false, std::memory_order_seq_cst);
+
+            const auto begin = system::builtin::rdtsc();
+            for (auto &slot : _visible_readers)
+            {
+                while (slot.value().load(std::memory_order_acquire) == this)
+                {
+                    system::builtin::pause();
+                }
+            }
+            const auto end = system::builtin::rdtsc();
+
+            _inhibit_until = end + (end - begin) * tasking::config::rw_latch_bias_inhibit_factor();
+        }
+    }
+
+    /**
+     * Releases the latch acquired for writing.
+     */
+    void unlock() noexcept { _rw_latch.unlock(); }
+
+    /**
+     * @return True, when readers are published in the visible readers table.
+     */
+    [[nodiscard]] bool is_reader_biased() const noexcept { return _is_reader_biased.load(std::memory_order_relaxed); }
+
+private:
+    // Slot per channel publishing the latch a reader holds.
+    inline static std::array<util::aligned_t<std::atomic<const BiasedRWSpinLock *>>, tasking::config::max_cores()>
+        _visible_readers{};
+
+    // Latch for writers and readers not using the bias.
+    RWSpinLock _rw_latch;
+
+    // Are readers allowed to publish in the visible readers table?
+    std::atomic_bool _is_reader_biased{true};
+
+    // Time stamp until the bias must not be re-enabled.
+    std::uint64_t _inhibit_until{0U};
+};
+} // namespace mx::synchronization
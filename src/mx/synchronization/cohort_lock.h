@@ -0,0 +1,159 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mx/memory/config.h>
+#include <mx/system/builtin.h>
+#include <mx/tasking/config.h>
+
+namespace mx::synchronization {
+/**
+ * NUMA-aware cohort lock (Dice et al.), composed of a global
+ * test-and-test-and-set lock and one MCS queue per NUMA region.
+ * Cores of the same region queue up locally; the owner of the
+ * global lock passes it to its local successor without releasing
+ * it globally. Thus, the lock (and the data it protects) stays
+ * within one region for a while, instead of bouncing between
+ * sockets on every hand over. To keep the lock fair, the global
+ * lock is released after a bounded number of local hand overs.
+ */
+class CohortLock
+{
+public:
+    /**
+     * The queue node is enqueued by every core that acquires the lock.
+     */
+    class alignas(64) QueueNode
+    {
+        friend class CohortLock;
+
+    public:
+        constexpr QueueNode() noexcept = default;
+        ~QueueNode() noexcept = default;
+
+    private:
+        enum State : std::uint8_t
+        {
+            Waiting,       // Predecessor still holds the lock.
+            AcquireGlobal, // Predecessor released the global lock; acquire it.
+            OwnsGlobal     // Predecessor passed the global lock.
+        };
+
+        // Next waiting core of the same NUMA region, set by the successor.
+        std::atomic<QueueNode *> _next{nullptr};
+
+        // State the owner of this node spins on; set by the predecessor.
+        std::atomic<State> _state{Waiting};
+
+        // Number of local hand overs since the global lock was acquired.
+        std::uint32_t _local_handovers{0U};
+    };
+
+    constexpr CohortLock() noexcept = default;
+    ~CohortLock() noexcept = default;
+
+    /**
+     * Locks the lock by enqueueing the given node at the queue of
+     * the given NUMA region and, if needed, acquiring the global lock.
+     *
+     * @param node Queue node of the caller.
+     * @param numa_node_id NUMA region of the caller.
+     */
+    void lock(QueueNode &node, const std::uint8_t numa_node_id) noexcept
+    {
+        node._next.store(nullptr, std::memory_order_relaxed);
+        node._state.store(QueueNode::Waiting, std::memory_order_relaxed);
+
+        auto *predecessor = _local_tails[numa_node_id].exchange(&node, std::memory_order_acq_rel);
+        if (predecessor != nullptr)
+        {
+            predecessor->_next.store(&node, std::memory_order_release);
+
+            auto state = QueueNode::Waiting;
+            while ((state = node._state.load(std::memory_order_acquire)) == QueueNode::Waiting)
+            {
+                system::builtin::pause();
+            }
+
+            if (state == QueueNode::OwnsGlobal)
+            {
+                return;
+            }
+        }
+
+        node._local_handovers = 0U;
+        lock_global();
+    }
+
+    /**
+     * Unlocks the lock. When a core of the same NUMA region is waiting,
+     * the global lock is passed; otherwise, the global lock is released.
+     *
+     * @param node Queue node the lock was acquired with.
+     * @param numa_node_id NUMA region of the caller.
+     */
+    void unlock(QueueNode &node, const std::uint8_t numa_node_id) noexcept
+    {
+        auto *successor = node._next.load(std::memory_order_acquire);
+        if (successor != nullptr && node._local_handovers < tasking::config::cohort_latch_max_local_handovers())
+        {
+            successor->_local_handovers = node._local_handovers + 1U;
+            successor->_state.store(QueueNode::OwnsGlobal, std::memory_order_release);
+            return;
+        }
+
+        // No (or no more) local hand over: Cores of other regions may acquire the global lock.
+        _global_flag.store(false, std::memory_order_release);
+
+        if (successor == nullptr)
+        {
+            auto *expected = &node;
+            if (_local_tails[numa_node_id].compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel))
+            {
+                return;
+            }
+
+            // A successor swapped the tail but did not link itself, yet.
+            while ((successor = node._next.load(std::memory_order_acquire)) == nullptr)
+            {
+                system::builtin::pause();
+            }
+        }
+
+        successor->_state.store(QueueNode::AcquireGlobal, std::memory_order_release);
+    }
+
+    /**
+     * @return True, if the lock is in use.
+     */
+    [[nodiscard]] bool is_locked() const noexcept { return _global_flag.load(std::memory_order_relaxed); }
+
+private:
+    // Global lock, held by the NUMA region currently owning the lock.
+    std::atomic_bool _global_flag{false};
+
+    // Tail of the queue for every NUMA region.
+    std::array<std::atomic<QueueNode *>, memory::config::max_numa_nodes()> _local_tails{};
+
+    /**
+     * Acquires the global lock by spinning until it is lockable.
+     */
+    void lock_global() noexcept
+    {
+        while (true)
+        {
+            while (_global_flag.load(std::memory_order_relaxed))
+            {
+                system::builtin::pause();
+            }
+
+            bool expected = false;
+            if (_global_flag.compare_exchange_weak(expected, true, std::memory_order_acquire))
+            {
+                return;
+            }
+        }
+    }
+};
+} // namespace mx::synchronization
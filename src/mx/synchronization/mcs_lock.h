@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mx/system/builtin.h>
+
+namespace mx::synchronization {
+/**
+ * Queue-based spinlock (Mellor-Crummey and Scott) for mutual exclusion.
+ * Every waiting core enqueues its own queue node and spins on a flag
+ * within that node instead of the shared lock word. Thus, the lock
+ * is handed over in FIFO order and only the cache line of the
+ * successor is touched on unlock.
+ * The queue node has to stay alive while the lock is held, typically
+ * it lives on the stack of the locking scope.
+ */
+class MCSLock
+{
+public:
+    /**
+     * The queue node is enqueued by every core that acquires the lock.
+     */
+    class alignas(64) QueueNode
+    {
+        friend class MCSLock;
+
+    public:
+        constexpr QueueNode() noexcept = default;
+        ~QueueNode() noexcept = default;
+
+    private:
+        // Next waiting core, set by the successor.
+        std::atomic<QueueNode *> _next{nullptr};
+
+        // Flag the owner of this node spins on; reset by the predecessor.
+        std::atomic_bool _is_waiting{false};
+    };
+
+    constexpr MCSLock() noexcept = default;
+    ~MCSLock() noexcept = default;
+
+    /**
+     * Locks the lock by enqueueing the given node and spinning
+     * until the predecessor handed over the lock.
+     *
+     * @param node Queue node of the caller.
+     */
+    void lock(QueueNode &node) noexcept
+    {
+        node._next.store(nullptr, std::memory_order_relaxed);
+        node._is_waiting.store(true, std::memory_order_relaxed);
+
+        auto *predecessor = _tail.exchange(&node, std::memory_order_acq_rel);
+        if (predecessor != nullptr)
+        {
+            predecessor->_next.store(&node, std::memory_order_release);
+            while (node._is_waiting.load(std::memory_order_acquire))
+            {
+                system::builtin::pause();
+            }
+        }
+    }
+
+    /**
+     * Try to lock the lock.
+     *
+     * @param node Queue node of the caller.
+     * @return True, when successfully locked.
+     */
+    bool try_lock(QueueNode &node) noexcept
+    {
+        node._next.store(nullptr, std::memory_order_relaxed);
+        QueueNode *expected = nullptr;
+        return _tail.compare_exchange_strong(expected, &node, std::memory_order_acq_rel);
+    }
+
+    /**
+     * Unlocks the lock and hands it over to the successor, if any.
+     *
+     * @param node Queue node the lock was acquired with.
+     */
+    void unlock(QueueNode &node) noexcept
+    {
+        auto *successor = node._next.load(std::memory_order_acquire);
+        if (successor == nullptr)
+        {
+            auto *expected = &node;
+            if (_tail.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel))
+            {
+                return;
+            }
+
+            // A successor swapped the tail but did not link itself, yet.
+            while ((successor = node._next.load(std::memory_order_acquire)) == nullptr)
+            {
+                system::builtin::pause();
+            }
+        }
+
+        successor->_is_waiting.store(false, std::memory_order_release);
+    }
+
+    /**
+     * @return True, if the lock is in use.
+     */
+    [[nodiscard]] bool is_locked() const noexcept { return _tail.load(std::memory_order_relaxed) != nullptr; }
+
+private:
+    // Last enqueued node; nullptr when the lock is free.
+    std::atomic<QueueNode *> _tail{nullptr};
+};
+} // namespace mx::synchronization
@@ -41,6 +41,14 @@ public:
         return version == _version.load(std::memory_order_seq_cst);
     }
 
+    /**
+     * @return True, if the lock is acquired by a writer.
+     */
+    [[nodiscard]] bool is_locked() const noexcept
+    {
+        return OptimisticLock::is_locked(_version.load(std::memory_order_relaxed));
+    }
+
     /**
      * Tries to acquire the lock.
      * @return True, when lock was acquired.
@@ -54,25 +62,28 @@ public:
 
     /**
      * Waits until the lock is successfully acquired.
+     * @return Number of failed tries to acquire the lock.
      */
-    template <bool SINGLE_WRITER> void lock() noexcept
+    template <bool SINGLE_WRITER> std::uint32_t lock() noexcept
     {
         if constexpr (SINGLE_WRITER)
         {
             _version.fetch_add(0b10, std::memory_order_seq_cst);
+            return 0U;
         }
         else
         {
-            auto tries = std::uint64_t{1U};
+            auto tries = std::uint32_t{0U};
             while (this->try_lock() == false)
             {
-                const auto wait = tries++;
+                const auto wait = ++tries;
                 for (auto i = 0U; i < wait * 32U; ++i)
                 {
                     system::builtin::pause();
                     std::atomic_thread_fence(std::memory_order_seq_cst);
                 }
             }
+            return tries;
         }
     }
 
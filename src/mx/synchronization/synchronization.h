@@ -17,11 +17,14 @@ enum class isolation_level : std::uint8_t
  */
 enum class protocol : std::uint8_t
 {
-    None = 0U,               // System is free to choose
-    Queue = 1U,              // Choose primitive with queues with respect to isolation level
-    Latch = 2U,              // Choose primitive with latches with respect to isolation level
-    OLFIT = 3U,              // Try to choose olfit
-    TransactionalMemory = 4U // Try to choose htm
+    None = 0U,                // System is free to choose
+    Queue = 1U,               // Choose primitive with queues with respect to isolation level
+    Latch = 2U,               // Choose primitive with latches with respect to isolation level
+    OLFIT = 3U,               // Try to choose olfit
+    TransactionalMemory = 4U, // Try to choose htm
+    MCSLatch = 5U,            // Choose a queue-based (MCS) latch for all accesses
+    CohortLatch = 6U,         // Choose a NUMA-aware cohort latch for all accesses
+    Adaptive = 7U             // Switch between olfit and scheduled writers at runtime
 };
 
 /**
@@ -40,7 +43,10 @@ enum class primitive : std::uint8_t
     ScheduleAll = 2U,       // All accesses will be scheduled to the mapped channel
     ReaderWriterLatch = 3U, // Use a reader/writer latch to enable parallel reads
     ScheduleWriter = 4U,    // Reads can perform anywhere, writes are scheduled to the mapped channel
-    OLFIT = 5U              // Read/write anywhere but use a latch for writers
+    OLFIT = 5U,             // Read/write anywhere but use a latch for writers
+    MCSLatch = 6U,          // All accesses will use a queue-based (MCS) latch
+    CohortLatch = 7U,       // All accesses will use a NUMA-aware cohort latch
+    Adaptive = 8U           // Like OLFIT or ScheduleWriter, switched at runtime based on conflicts
 };
 
 /**
@@ -51,7 +57,8 @@ enum class primitive : std::uint8_t
  */
 static inline bool is_optimistic(const primitive primitive_) noexcept
 {
-    return primitive_ == primitive::ScheduleWriter || primitive_ == primitive::OLFIT;
+    return primitive_ == primitive::ScheduleWriter || primitive_ == primitive::OLFIT ||
+           primitive_ == primitive::Adaptive;
 }
 
 } // namespace mx::synchronization
\ No newline at end of file
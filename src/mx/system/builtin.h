@@ -22,6 +22,25 @@ public:
 #endif
     }
 
+    /**
+     * Reads the time stamp counter of the cpu, independently
+     * of the hardware.
+     *
+     * @return Current value of the time stamp counter.
+     */
+    static std::uint64_t rdtsc() noexcept
+    {
+#if defined(__x86_64__) || defined(__amd64__)
+        return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+        std::uint64_t counter;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(counter));
+        return counter;
+#else
+        return 0U;
+#endif
+    }
+
     [[maybe_unused]] static bool expect_false(const bool expression) noexcept
     {
         return __builtin_expect(expression, false);
@@ -23,6 +23,11 @@ public:
         write = 1U
     };
 
+    /**
+     * @return Size of a single cache line in bytes.
+     */
+    static constexpr std::uint32_t line_size() noexcept { return 64U; }
+
     /**
      * Prefetches a single cache line into a given prefetch level.
      *
@@ -39,11 +44,11 @@ public:
         }
         else if constexpr (L == level::L1)
         {
-            asm volatile("PREFETCHT1 (%0)\n" ::"r"(address));
+            asm volatile("PREFETCHT0 (%0)\n" ::"r"(address));
         }
         else if constexpr (L == level::L2)
         {
-            asm volatile("PREFETCHT2 (%0)\n" ::"r"(address));
+            asm volatile("PREFETCHT1 (%0)\n" ::"r"(address));
         }
         else
         {
@@ -183,5 +188,78 @@ public:
             prefetch_range<L, A>(address, S);
         }
     }
+
+    /**
+     * Prefetches a single cache line, the cache level and access
+     * are chosen at runtime.
+     *
+     * @param level_ Wanted cache level.
+     * @param access_ Access to the cache line whether read or write.
+     * @param address Address of the memory which should be prefetched.
+     */
+    static void prefetch(const level level_, const access access_, void *address) noexcept
+    {
+        if (access_ == access::write)
+        {
+            prefetch<access::write>(level_, address);
+        }
+        else
+        {
+            prefetch<access::read>(level_, address);
+        }
+    }
+
+    /**
+     * Prefetches a range of cache lines, the cache level and access
+     * are chosen at runtime.
+     *
+     * @param level_ Wanted cache level.
+     * @param access_ Access to the cache line whether read or write.
+     * @param address Address of the memory which should be prefetched.
+     * @param size Size of the accessed memory.
+     */
+    static void prefetch_range(const level level_, const access access_, void *address,
+                               const std::uint32_t size) noexcept
+    {
+        if (access_ == access::write)
+        {
+            prefetch_range<access::write>(level_, address, size);
+        }
+        else
+        {
+            prefetch_range<access::read>(level_, address, size);
+        }
+    }
+
+private:
+    template <access A> static void prefetch(const level level_, void *address) noexcept
+    {
+        switch (level_)
+        {
+        case level::L1:
+            prefetch<level::L1, A>(address);
+            break;
+        case level::L2:
+            prefetch<level::L2, A>(address);
+            break;
+        default:
+            prefetch<level::LLC, A>(address);
+        }
+    }
+
+    template <access A> static void prefetch_range(const level level_, void *address, const std::uint32_t size) noexcept
+    {
+        switch (level_)
+        {
+        case level::L1:
+            prefetch_range<level::L1, A>(address, size);
+            break;
+        case level::L2:
+            prefetch_range<level::L2, A>(address, size);
+            break;
+        default:
+            prefetch_range<level::LLC, A>(address, size);
+        }
+    }
 };
 } // namespace mx::system
\ No newline at end of file
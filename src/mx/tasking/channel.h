@@ -44,11 +44,35 @@ public:
      */
     [[nodiscard]] std::uint16_t id() const noexcept { return _id; }
 
+    /**
+     * @return Identifier of the NUMA region the channel is located in.
+     */
+    [[nodiscard]] std::uint8_t numa_node_id() const noexcept { return _numa_node_id; }
+
     /**
      * @return The next task to be executed.
      */
     TaskInterface *next() noexcept { return _task_buffer.next(); }
 
+    /**
+     * @return The next task to be executed, without taking it out of the buffer.
+     */
+    [[nodiscard]] TaskInterface *peek() const noexcept { return _task_buffer.peek(); }
+
+    /**
+     * @return Distance of prefetched tasks.
+     */
+    [[nodiscard]] std::uint8_t prefetch_distance() const noexcept { return _task_buffer.prefetch_distance(); }
+
+    /**
+     * Updates the distance of prefetched tasks.
+     * @param prefetch_distance New prefetch distance.
+     */
+    void prefetch_distance(const std::uint8_t prefetch_distance) noexcept
+    {
+        _task_buffer.prefetch_distance(prefetch_distance);
+    }
+
     /**
      * Schedules the task to thread-safe queue with regard to the NUMA region
      * of the producer. Producer of different NUMA regions should not share
@@ -83,6 +107,11 @@ public:
             size = fill<priority::low>(config::task_buffer_size());
         }
 
+        if constexpr (config::measure_channel_load())
+        {
+            _occupancy.measure(size);
+        }
+
         return size;
     }
 
@@ -105,10 +134,14 @@ public:
     [[nodiscard]] bool empty() const noexcept { return _task_buffer.empty(); }
 
     /**
-     * Adds usage prediction of a resource to this channel.
+     * Adds usage prediction of resources to this channel.
      * @param usage Predicted usage.
+     * @param count Number of resources.
      */
-    void predict_usage(const resource::hint::expected_access_frequency usage) noexcept { _occupancy.predict(usage); }
+    void predict_usage(const resource::hint::expected_access_frequency usage, const std::uint64_t count = 1U) noexcept
+    {
+        _occupancy.predict(usage, count);
+    }
 
     /**
      * Updates the usage prediction of this channel.
@@ -130,6 +163,11 @@ public:
         return static_cast<resource::hint::expected_access_frequency>(_occupancy);
     }
 
+    /**
+     * @return Load of this channel, weighing predicted usages and (if enabled) measured load.
+     */
+    [[nodiscard]] std::uint64_t load() const noexcept { return _occupancy.load(); }
+
     /**
      * @return True, whenever min. one prediction was "excessive".
      */
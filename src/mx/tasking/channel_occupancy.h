@@ -2,11 +2,12 @@
 
 #include <array>
 #include <atomic>
+#include <cstdint>
 #include <mx/resource/resource.h>
 
 namespace mx::tasking {
 /**
- * Stores usage predictions.
+ * Stores usage predictions and, optionally, the measured load of a channel.
  */
 class ChannelOccupancy
 {
@@ -17,10 +18,13 @@ public:
     /**
      * Adds the given predicted usage.
      * @param predicted_usage Predicted usage.
+     * @param count Number of resources with this predicted usage.
      */
-    void predict(const resource::hint::expected_access_frequency predicted_usage) noexcept
+    void predict(const resource::hint::expected_access_frequency predicted_usage,
+                 const std::uint64_t count = 1U) noexcept
     {
-        _predicted_usage_counter[static_cast<std::uint8_t>(predicted_usage)].fetch_add(1, std::memory_order_relaxed);
+        _predicted_usage_counter[static_cast<std::uint8_t>(predicted_usage)].fetch_add(count,
+                                                                                         std::memory_order_relaxed);
     }
 
     /**
@@ -32,6 +36,45 @@ public:
         _predicted_usage_counter[static_cast<std::uint8_t>(predicted_usage)].fetch_sub(1, std::memory_order_relaxed);
     }
 
+    /**
+     * Records the number of tasks the channel fetched for execution.
+     * The measured load is a moving average over the recorded fills.
+     *
+     * @param count_tasks Number of tasks in the task buffer after filling.
+     */
+    void measure(const std::uint16_t count_tasks) noexcept
+    {
+        const auto measured_load = _measured_load.load(std::memory_order_relaxed);
+        _measured_load.store(measured_load - (measured_load >> 3U) + count_tasks, std::memory_order_relaxed);
+    }
+
+    /**
+     * Weighs the predicted usages and the measured load: A few excessive
+     * or high used resources outweigh many normal used resources.
+     *
+     * @return Load of the channel.
+     */
+    [[nodiscard]] std::uint64_t load() const noexcept
+    {
+        auto load = std::uint64_t{_measured_load.load(std::memory_order_relaxed) >> 3U};
+        for (auto i = 0U; i < _predicted_usage_counter.size(); ++i)
+        {
+            load += _predicted_usage_counter[i].load(std::memory_order_relaxed) * _predicted_usage_weight[i];
+        }
+
+        return load;
+    }
+
+    /**
+     * @param predicted_usage Predicted usage.
+     * @return Load a single resource with the given predicted usage adds to a channel.
+     */
+    [[nodiscard]] static constexpr std::uint64_t weight(
+        const resource::hint::expected_access_frequency predicted_usage) noexcept
+    {
+        return _predicted_usage_weight[static_cast<std::uint8_t>(predicted_usage)];
+    }
+
     /**
      * @return True, when at least one prediction was "excessive".
      */
@@ -67,6 +110,12 @@ private:
     // Counter of predicted usages.
     std::array<std::atomic_uint64_t, 4U> _predicted_usage_counter{0U};
 
+    // Weight of every predicted usage (excessive, high, normal, unused) for the load.
+    static constexpr std::array<std::uint64_t, 4U> _predicted_usage_weight{{64U, 8U, 1U, 0U}};
+
+    // Moving average of tasks per fill, scaled by eight.
+    std::atomic_uint32_t _measured_load{0U};
+
     /**
      * @return True, when at least one usage as given by the template was predicted.
      */
@@ -8,26 +8,90 @@ public:
     {
         None = 0U,
         UpdateEpochOnRead = 1U,
-        UpdateEpochPeriodically = 2U
+        UpdateEpochPeriodically = 2U,
+        QuiescentState = 3U
     };
 
-    // Maximal number of supported cores.
+    // Maximal number of supported cores. Resource pointers store the
+    // channel id with 9 bits, which limits the cores to 512.
     static constexpr auto max_cores() { return 128U; }
 
+    // If enabled, every channel records histograms of the queueing delay
+    // (spawn to start) and the execution time (start to end) of every
+    // task type, measured in cycles. Only the first types seen by a
+    // channel are recorded.
+    static constexpr auto task_latency_histograms() { return false; }
+    static constexpr auto max_task_latency_types() { return 16U; }
+
+    // If enabled, every channel records its latest executed tasks and
+    // fills of the task buffer in a ring buffer of the given number of
+    // events (a power of two), which can be written as a timeline.
+    static constexpr auto task_tracing() { return false; }
+    static constexpr auto trace_buffer_size() { return 8192U; }
+
     // Maximal size for a single task, will be used for task allocation.
-    static constexpr auto task_size() { return 64U; }
+    // Recording latencies or traces stores the spawn time stamp in every
+    // task, which does not fit tasks filling a cache line.
+    static constexpr auto task_size() { return task_latency_histograms() || task_tracing() ? 128U : 64U; }
 
     // The task buffer will hold a set of tasks, fetched from
     // queues. This is the size of the buffer.
     static constexpr auto task_buffer_size() { return 64U; }
 
+    // Bounds of the prefetch distance, when the distance
+    // is tuned automatically by every worker at runtime.
+    static constexpr auto min_prefetch_distance() { return 1U; }
+    static constexpr auto max_prefetch_distance() { return 16U; }
+
+    // Number of executed tasks the worker samples before the
+    // automatically tuned prefetch distance is re-evaluated.
+    static constexpr auto prefetch_distance_sample_size() { return 2048U; }
+
+    // Number of times the NUMA cohort latch is passed between cores
+    // of the same NUMA region, before it is released to other regions.
+    static constexpr auto cohort_latch_max_local_handovers() { return 64U; }
+
+    // After revoking the reader bias of a reader/writer latch, the
+    // bias is inhibited for this multiple of the revocation time.
+    static constexpr auto rw_latch_bias_inhibit_factor() { return 9U; }
+
+    // Resources synchronized adaptively sample one of n accesses (drawn
+    // randomly); after a window of samples, the primitive may be switched.
+    static constexpr auto adaptive_synchronization_sample_rate() { return 16U; }
+    static constexpr auto adaptive_synchronization_window() { return 64U; }
+
+    // Conflicts (in percent of accesses) to schedule writers of adaptively
+    // synchronized resources to their channel; and to let them execute
+    // anywhere again (lower, to avoid switching back and forth).
+    static constexpr auto adaptive_synchronization_schedule_threshold() { return 10U; }
+    static constexpr auto adaptive_synchronization_olfit_threshold() { return 2U; }
+
+    // Maximal number of resources a single task can be annotated with.
+    static constexpr auto max_annotated_resources() { return 4U; }
+
+    // Maximal number of consecutive writers of a ScheduleWriter-resource
+    // that are executed within a single version window.
+    static constexpr auto max_batched_writers() { return 8U; }
+
+    // If enabled, every channel measures its load (tasks per fill), which
+    // is weighed with the predicted usage when placing new resources.
+    static constexpr auto measure_channel_load() { return false; }
+
+    // Resources with affinity to a channel are placed there, unless that
+    // channel is more loaded than the alternative by this value (which is
+    // the weight of a single resource with high predicted usage).
+    static constexpr auto resource_affinity_tolerance() { return 8U; }
+
     // If enabled, will record the number of execute tasks,
     // scheduled tasks, reader and writer per core and more.
     static constexpr auto task_statistics() { return false; }
 
     // If enabled, memory will be reclaimed while using optimistic
     // synchronization by epoch-based reclamation. Otherwise, freeing
-    // memory is unsafe.
+    // memory is unsafe. Workers announce the global epoch before
+    // every optimistic read (UpdateEpochOnRead), on every fill of
+    // the task buffer (UpdateEpochPeriodically), or, without fences,
+    // between two tasks as a quiescent state (QuiescentState).
     static constexpr auto memory_reclamation() { return memory_reclamation_scheme::UpdateEpochPeriodically; }
 };
 } // namespace mx::tasking
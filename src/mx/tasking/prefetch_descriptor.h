@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <mx/system/cache.h>
+
+namespace mx::tasking {
+/**
+ * The prefetch descriptor describes what will be prefetched for the
+ * annotated resource of a task, before the task is executed. Either,
+ * a contiguous range at the start of the resource is prefetched or
+ * the task itself is asked to prefetch by calling its prefetch() hook.
+ * The latter allows tasks to prefetch exactly that part of the resource
+ * they will access (e.g., a hash bucket or the keys of a tree node
+ * probed by a binary search).
+ *
+ * In addition, the descriptor may specify the target cache level and
+ * the access (read or write). Otherwise, the hints of the resource
+ * and the task (reading or writing) are used.
+ *
+ * The descriptor fits into 16 bits to keep the task annotation small.
+ */
+class PrefetchDescriptor
+{
+public:
+    /**
+     * @return Descriptor that lets the runtime call the prefetch() hook of the task.
+     */
+    static constexpr PrefetchDescriptor make_callback() noexcept { return PrefetchDescriptor{0U, true, 0U, 0U}; }
+
+    /**
+     * @param level Cache level the task should prefetch to.
+     * @return Descriptor that lets the runtime call the prefetch() hook of the task.
+     */
+    static constexpr PrefetchDescriptor make_callback(const system::cache::level level) noexcept
+    {
+        return PrefetchDescriptor{0U, true, static_cast<std::uint32_t>(level), 0U};
+    }
+
+    /**
+     * @param level Cache level the task should prefetch to.
+     * @param access Access the task should prefetch for.
+     * @return Descriptor that lets the runtime call the prefetch() hook of the task.
+     */
+    static constexpr PrefetchDescriptor make_callback(const system::cache::level level,
+                                                      const system::cache::access access) noexcept
+    {
+        return PrefetchDescriptor{0U, true, static_cast<std::uint32_t>(level), PrefetchDescriptor::encode(access)};
+    }
+
+    constexpr PrefetchDescriptor() noexcept : _cache_lines(0U), _is_callback(0U), _level(0U), _access(0U) {}
+
+    /**
+     * Creates a descriptor for prefetching a contiguous range at the start of the resource.
+     *
+     * @param size Size in bytes, will be rounded up to cache lines.
+     */
+    constexpr PrefetchDescriptor(const std::uint16_t size) noexcept
+        : PrefetchDescriptor(PrefetchDescriptor::cache_lines(size), false, 0U, 0U)
+    {
+    }
+
+    /**
+     * Creates a descriptor for prefetching a contiguous range at the start of the resource.
+     *
+     * @param size Size in bytes, will be rounded up to cache lines.
+     * @param level Cache level the range is prefetched to.
+     */
+    constexpr PrefetchDescriptor(const std::uint16_t size, const system::cache::level level) noexcept
+        : PrefetchDescriptor(PrefetchDescriptor::cache_lines(size), false, static_cast<std::uint32_t>(level), 0U)
+    {
+    }
+
+    /**
+     * Creates a descriptor for prefetching a contiguous range at the start of the resource.
+     *
+     * @param size Size in bytes, will be rounded up to cache lines.
+     * @param level Cache level the range is prefetched to.
+     * @param access Access the range is prefetched for.
+     */
+    constexpr PrefetchDescriptor(const std::uint16_t size, const system::cache::level level,
+                                 const system::cache::access access) noexcept
+        : PrefetchDescriptor(PrefetchDescriptor::cache_lines(size), false, static_cast<std::uint32_t>(level),
+                             PrefetchDescriptor::encode(access))
+    {
+    }
+
+    constexpr PrefetchDescriptor(const PrefetchDescriptor &) noexcept = default;
+    ~PrefetchDescriptor() noexcept = default;
+
+    PrefetchDescriptor &operator=(const PrefetchDescriptor &) noexcept = default;
+
+    /**
+     * @return Size of the range prefetched at the start of the resource.
+     */
+    [[nodiscard]] std::uint32_t size() const noexcept { return _cache_lines * system::cache::line_size(); }
+
+    /**
+     * @return True, when the prefetch() hook of the task should be called.
+     */
+    [[nodiscard]] bool is_callback() const noexcept { return _is_callback; }
+
+    /**
+     * @return True, when nothing should be prefetched for the resource.
+     */
+    [[nodiscard]] bool empty() const noexcept { return _cache_lines == 0U && _is_callback == false; }
+
+    /**
+     * @return True, when the descriptor specifies the cache level.
+     */
+    [[nodiscard]] bool has_level() const noexcept { return _level != 0U; }
+
+    /**
+     * @return The cache level to prefetch to.
+     */
+    [[nodiscard]] system::cache::level level() const noexcept { return static_cast<system::cache::level>(_level); }
+
+    /**
+     * @return True, when the descriptor specifies the access.
+     */
+    [[nodiscard]] bool has_access() const noexcept { return _access != 0U; }
+
+    /**
+     * @return The access (read or write) to prefetch for.
+     */
+    [[nodiscard]] system::cache::access access() const noexcept
+    {
+        return _access == 2U ? system::cache::access::write : system::cache::access::read;
+    }
+
+    /**
+     * Completes the descriptor with the given cache level and access,
+     * when the descriptor does not specify them itself.
+     *
+     * @param level Cache level, when not specified by the descriptor.
+     * @param access Access, when not specified by the descriptor.
+     * @return Descriptor specifying cache level and access.
+     */
+    [[nodiscard]] PrefetchDescriptor complete(const system::cache::level level,
+                                              const system::cache::access access) const noexcept
+    {
+        const auto completed_level = has_level() ? std::uint32_t(_level) : static_cast<std::uint32_t>(level);
+        const auto completed_access = has_access() ? std::uint32_t(_access) : PrefetchDescriptor::encode(access);
+        return PrefetchDescriptor{_cache_lines, _is_callback == 1U, completed_level, completed_access};
+    }
+
+private:
+    constexpr PrefetchDescriptor(const std::uint32_t cache_lines, const bool is_callback, const std::uint32_t level,
+                                 const std::uint32_t access) noexcept
+        : _cache_lines(cache_lines), _is_callback(is_callback), _level(level), _access(access)
+    {
+        assert(cache_lines < (1U << 11U) && "Prefetched range is too big.");
+    }
+
+    /**
+     * Calculates the number of cache lines for a given size.
+     * @param size Size in bytes.
+     * @return Number of (started) cache lines.
+     */
+    static constexpr std::uint32_t cache_lines(const std::uint32_t size) noexcept
+    {
+        return (size + system::cache::line_size() - 1U) / system::cache::line_size();
+    }
+
+    /**
+     * Encodes the access, leaving zero for an unspecified access.
+     * @param access Access (read or write).
+     * @return Encoded access.
+     */
+    static constexpr std::uint32_t encode(const system::cache::access access) noexcept
+    {
+        return access == system::cache::access::write ? 2U : 1U;
+    }
+
+    // Number of cache lines prefetched at the start of the resource.
+    std::uint16_t _cache_lines : 11;
+
+    // Call the prefetch() hook of the task?
+    std::uint16_t _is_callback : 1;
+
+    // Target cache level (1 = L1, 2 = L2, 3 = LLC); 0 when not specified.
+    std::uint16_t _level : 2;
+
+    // Access + 1 (1 = read, 2 = write); 0 when not specified.
+    std::uint16_t _access : 2;
+};
+} // namespace mx::tasking
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "config.h"
+#include <cstdint>
+#include <limits>
+#include <mx/system/builtin.h>
+
+namespace mx::tasking {
+/**
+ * The prefetch distance specifies how many tasks before execution
+ * the data of a task will be prefetched. The distance is either
+ * fixed (where 0 disables prefetching) or tuned at runtime by every
+ * worker, individually.
+ */
+class PrefetchDistance
+{
+public:
+    /**
+     * @return Prefetch distance that will be tuned at runtime.
+     */
+    static constexpr PrefetchDistance make_automatic() noexcept
+    {
+        return PrefetchDistance{std::numeric_limits<std::uint16_t>::max()};
+    }
+
+    constexpr PrefetchDistance(const std::uint16_t distance) noexcept : _distance(distance) {}
+    constexpr PrefetchDistance(const PrefetchDistance &) noexcept = default;
+    ~PrefetchDistance() noexcept = default;
+
+    PrefetchDistance &operator=(const PrefetchDistance &) noexcept = default;
+
+    /**
+     * @return True, when the distance is tuned at runtime.
+     */
+    [[nodiscard]] constexpr bool is_automatic() const noexcept
+    {
+        return _distance == std::numeric_limits<std::uint16_t>::max();
+    }
+
+    /**
+     * @return The fixed distance or, when tuned at runtime, the distance to start with.
+     */
+    [[nodiscard]] constexpr std::uint8_t initial() const noexcept
+    {
+        return is_automatic() ? config::min_prefetch_distance() : _distance;
+    }
+
+private:
+    std::uint16_t _distance;
+};
+
+/**
+ * The tuner measures the cycles spent per executed task, while
+ * the worker is busy. After every sample, the prefetch distance
+ * is moved by one step; whenever the cycles per task got worse,
+ * the direction will be reversed (hill climbing). Thus, the
+ * distance will settle around the best distance for the
+ * current workload and be re-adjusted when the workload changes.
+ */
+class PrefetchDistanceTuner
+{
+public:
+    constexpr explicit PrefetchDistanceTuner(const PrefetchDistance distance) noexcept
+        : _is_enabled(distance.is_automatic()), _distance(distance.initial())
+    {
+    }
+    ~PrefetchDistanceTuner() noexcept = default;
+
+    /**
+     * @return True, when the prefetch distance is tuned at runtime.
+     */
+    [[nodiscard]] bool is_enabled() const noexcept { return _is_enabled; }
+
+    /**
+     * @return The current prefetch distance.
+     */
+    [[nodiscard]] std::uint8_t distance() const noexcept { return _distance; }
+
+    /**
+     * Starts a new measurement interval, e.g., when the worker
+     * was idle and received new tasks.
+     */
+    void restart() noexcept
+    {
+        _interval_begin = system::builtin::rdtsc();
+        _interval_tasks = 0U;
+    }
+
+    /**
+     * Counts an executed task.
+     */
+    void executed() noexcept { ++_interval_tasks; }
+
+    /**
+     * Closes the current measurement interval and starts a new one. Once the
+     * sample is complete, the prefetch distance will be adjusted.
+     *
+     * @return True, when the prefetch distance changed.
+     */
+    bool update() noexcept
+    {
+        const auto now = system::builtin::rdtsc();
+        _sample_cycles += now - _interval_begin;
+        _sample_tasks += _interval_tasks;
+        _interval_begin = now;
+        _interval_tasks = 0U;
+
+        if (_sample_tasks < config::prefetch_distance_sample_size())
+        {
+            return false;
+        }
+
+        const auto cycles_per_task = _sample_cycles / _sample_tasks;
+        _sample_cycles = 0U;
+        _sample_tasks = 0U;
+
+        if (cycles_per_task > _last_cycles_per_task)
+        {
+            _direction = -_direction;
+        }
+        _last_cycles_per_task = cycles_per_task;
+
+        const auto distance = static_cast<std::int32_t>(_distance) + _direction;
+        if (distance < static_cast<std::int32_t>(config::min_prefetch_distance()) ||
+            distance > static_cast<std::int32_t>(config::max_prefetch_distance()))
+        {
+            _direction = -_direction;
+            return false;
+        }
+
+        _distance = static_cast<std::uint8_t>(distance);
+        return true;
+    }
+
+private:
+    // Is the distance tuned at runtime?
+    const bool _is_enabled;
+
+    // Current prefetch distance.
+    std::uint8_t _distance;
+
+    // Direction of the next step (+1 or -1).
+    std::int8_t _direction{1};
+
+    // Executed tasks and time stamp of the current interval.
+    std::uint32_t _interval_tasks{0U};
+    std::uint64_t _interval_begin{0U};
+
+    // Executed tasks and spent cycles of the current sample.
+    std::uint64_t _sample_tasks{0U};
+    std::uint64_t _sample_cycles{0U};
+
+    // Cycles per task measured by the last sample.
+    std::uint64_t _last_cycles_per_task{std::numeric_limits<std::uint64_t>::max()};
+};
+} // namespace mx::tasking
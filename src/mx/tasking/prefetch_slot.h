@@ -21,29 +21,54 @@ public:
         _task = task;
         if (task->has_resource_annotated())
         {
-            _resource = std::make_pair(task->annotated_resource().get(), task->annotated_resource_size());
+            const auto resource = task->annotated_resource();
+
+            // The task may specify cache level and access. Otherwise, the level is taken
+            // from the resource and writing tasks prefetch for write access, which avoids
+            // requesting the ownership of the cache lines while executing the task.
+            const auto level = resource.has_prefetch_level() ? resource.prefetch_level() : system::cache::LLC;
+            const auto access = (resource.is_prefetched_for_write() || task->is_readonly() == false)
+                                    ? system::cache::write
+                                    : system::cache::read;
+            _resource = std::make_pair(resource.get(), task->annotated_prefetch_descriptor().complete(level, access));
+        }
+        else
+        {
+            _resource = std::make_pair(nullptr, PrefetchDescriptor{});
         }
         return *this;
     }
 
     void operator()() noexcept
     {
+        const auto descriptor = std::get<1>(_resource);
+
         if (_task != nullptr)
         {
             system::cache::prefetch<system::cache::L1, system::cache::write>(_task);
+
+            // The task knows best, what to prefetch.
+            if (descriptor.is_callback())
+            {
+                _task->prefetch(descriptor.level(), descriptor.access());
+            }
+
             _task = nullptr;
         }
 
         if (std::get<0>(_resource) != nullptr)
         {
-            system::cache::prefetch_range<system::cache::LLC, system::cache::read>(std::get<0>(_resource),
-                                                                                   std::get<1>(_resource));
+            if (descriptor.size() > 0U)
+            {
+                system::cache::prefetch_range(descriptor.level(), descriptor.access(), std::get<0>(_resource),
+                                              descriptor.size());
+            }
             std::get<0>(_resource) = nullptr;
         }
     }
 
 private:
-    void *_task = nullptr;
-    std::pair<void *, std::uint16_t> _resource = std::make_pair(nullptr, 0U);
+    TaskInterface *_task = nullptr;
+    std::pair<void *, PrefetchDescriptor> _resource = std::make_pair(nullptr, PrefetchDescriptor{});
 };
 } // namespace mx::tasking
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include "task_latency.h"
+#include <cstdlib>
+#include <cxxabi.h>
+
+using namespace mx::tasking::profiling;
+
+std::unordered_map<std::string, TaskLatency> TaskLatencies::get() const
+{
+    auto latencies = std::unordered_map<std::string, TaskLatency>{};
+    for (auto channel_id = 0U; this->_channels != nullptr && channel_id < this->_count_channels; ++channel_id)
+    {
+        for (const auto &slot : this->_channels[channel_id].slots)
+        {
+            if (slot.type == nullptr)
+            {
+                break;
+            }
+
+            // Type infos of the same type may differ between shared objects; names do not.
+            auto status = 0;
+            auto *demangled_name = abi::__cxa_demangle(slot.type->name(), nullptr, nullptr, &status);
+            auto &latency = latencies[status == 0 ? demangled_name : slot.type->name()];
+            std::free(demangled_name);
+
+            latency.queueing_delay.merge(slot.latency.queueing_delay);
+            latency.execution_time.merge(slot.latency.execution_time);
+        }
+    }
+
+    return latencies;
+}
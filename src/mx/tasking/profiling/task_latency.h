@@ -0,0 +1,234 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <mx/memory/global_heap.h>
+#include <mx/tasking/config.h>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace mx::tasking::profiling {
+/**
+ * Histogram of latencies (in cycles) with logarithmic buckets: every
+ * power of two is split into four buckets, thus, a recorded latency
+ * is known with a precision of 25%.
+ */
+class LatencyHistogram
+{
+public:
+    constexpr LatencyHistogram() noexcept = default;
+    ~LatencyHistogram() noexcept = default;
+
+    /**
+     * Records a single latency.
+     * @param cycles Latency in cycles.
+     */
+    void add(const std::uint64_t cycles) noexcept { ++_buckets[LatencyHistogram::bucket(cycles)]; }
+
+    /**
+     * Adds all latencies of another histogram.
+     * @param other Histogram to merge into this.
+     */
+    void merge(const LatencyHistogram &other) noexcept
+    {
+        for (auto i = 0U; i < COUNT_BUCKETS; ++i)
+        {
+            _buckets[i] += other._buckets[i];
+        }
+    }
+
+    /**
+     * @return Number of recorded latencies.
+     */
+    [[nodiscard]] std::uint64_t count() const noexcept
+    {
+        auto count = std::uint64_t{0U};
+        for (const auto bucket_count : _buckets)
+        {
+            count += bucket_count;
+        }
+        return count;
+    }
+
+    /**
+     * @param percentile Percentile in [0, 1], e.g., 0.99 for the p99.
+     * @return Upper bound of the bucket holding the given percentile; zero, if no latency was recorded.
+     */
+    [[nodiscard]] std::uint64_t percentile(const double percentile) const noexcept
+    {
+        const auto count = this->count();
+        if (count == 0U)
+        {
+            return 0U;
+        }
+
+        // Rank of the latency within all recorded latencies, starting at one.
+        const auto rank = std::max<std::uint64_t>(std::uint64_t(percentile * double(count) + 0.5), 1U);
+        auto seen = std::uint64_t{0U};
+        for (auto i = 0U; i < COUNT_BUCKETS; ++i)
+        {
+            seen += _buckets[i];
+            if (seen >= rank)
+            {
+                return LatencyHistogram::upper_bound(i);
+            }
+        }
+
+        return LatencyHistogram::upper_bound(COUNT_BUCKETS - 1U);
+    }
+
+private:
+    // Every power of two is split into 2^SUB_BUCKET_BITS buckets.
+    inline static constexpr auto SUB_BUCKET_BITS = 2U;
+    inline static constexpr auto SUB_BUCKETS = 1U << SUB_BUCKET_BITS;
+    inline static constexpr auto COUNT_BUCKETS = (64U - SUB_BUCKET_BITS + 1U) * SUB_BUCKETS;
+
+    std::array<std::uint64_t, COUNT_BUCKETS> _buckets{0U};
+
+    /**
+     * @param cycles Latency in cycles.
+     * @return Bucket of the latency.
+     */
+    [[nodiscard]] static std::uint16_t bucket(const std::uint64_t cycles) noexcept
+    {
+        if (cycles < SUB_BUCKETS)
+        {
+            return std::uint16_t(cycles);
+        }
+
+        const auto most_significant_bit = 63U - __builtin_clzl(cycles);
+        const auto sub_bucket = (cycles >> (most_significant_bit - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1U);
+        return std::uint16_t((most_significant_bit - SUB_BUCKET_BITS + 1U) * SUB_BUCKETS + sub_bucket);
+    }
+
+    /**
+     * @param bucket Bucket.
+     * @return Largest latency recorded in the given bucket.
+     */
+    [[nodiscard]] static std::uint64_t upper_bound(const std::uint16_t bucket) noexcept
+    {
+        if (bucket < SUB_BUCKETS)
+        {
+            return bucket;
+        }
+
+        const auto most_significant_bit = (bucket / SUB_BUCKETS) + SUB_BUCKET_BITS - 1U;
+        const auto width = std::uint64_t{1U} << (most_significant_bit - SUB_BUCKET_BITS);
+        const auto lower_bound = (std::uint64_t{1U} << most_significant_bit) | (bucket % SUB_BUCKETS) * width;
+        return lower_bound + (width - 1U);
+    }
+};
+
+/**
+ * Latencies of a single task type.
+ */
+struct TaskLatency
+{
+    // Time from spawning a task until its execution starts.
+    LatencyHistogram queueing_delay;
+
+    // Time of executing a task, including latching and re-running optimistic readers.
+    LatencyHistogram execution_time;
+};
+
+/**
+ * Collector for latencies of executed tasks, per channel and task type.
+ * Every channel only writes its own histograms; they are merged when read.
+ */
+class TaskLatencies
+{
+public:
+    explicit TaskLatencies(const std::uint16_t count_channels) noexcept : _count_channels(count_channels)
+    {
+        if constexpr (config::task_latency_histograms())
+        {
+            this->_channels = new (memory::GlobalHeap::allocate_cache_line_aligned(sizeof(ChannelLatencies) *
+                                                                                    count_channels))
+                ChannelLatencies[count_channels];
+        }
+    }
+
+    TaskLatencies(const TaskLatencies &) = delete;
+
+    ~TaskLatencies() noexcept { delete[] this->_channels; }
+
+    TaskLatencies &operator=(const TaskLatencies &) = delete;
+
+    /**
+     * Clears all recorded latencies.
+     */
+    void clear() noexcept
+    {
+        if (this->_channels != nullptr)
+        {
+            std::memset(static_cast<void *>(this->_channels), 0, sizeof(ChannelLatencies) * this->_count_channels);
+        }
+    }
+
+    /**
+     * Records the latencies of an executed task.
+     * @param channel_id Channel the task was executed on.
+     * @param type Type of the task.
+     * @param spawn_timestamp Time stamp (in cycles) the task was spawned.
+     * @param start_timestamp Time stamp (in cycles) the execution started.
+     * @param end_timestamp Time stamp (in cycles) the execution ended.
+     */
+    void record(const std::uint16_t channel_id, const std::type_info &type, const std::uint64_t spawn_timestamp,
+                const std::uint64_t start_timestamp, const std::uint64_t end_timestamp) noexcept
+    {
+        auto &channel = this->_channels[channel_id];
+
+        // Types are compared by their type info, which is unique within
+        // a binary. Types of tasks seen first get a slot; further are dropped.
+        for (auto i = 0U; i < config::max_task_latency_types(); ++i)
+        {
+            auto &slot = channel.slots[i];
+            if (slot.type == &type || slot.type == nullptr)
+            {
+                slot.type = &type;
+
+                // Timestamps of different cores are not necessarily in sync.
+                if (start_timestamp >= spawn_timestamp)
+                {
+                    slot.latency.queueing_delay.add(start_timestamp - spawn_timestamp);
+                }
+                slot.latency.execution_time.add(end_timestamp - start_timestamp);
+                return;
+            }
+        }
+    }
+
+    /**
+     * Merges the latencies of all channels. Histograms are read without
+     * synchronization; while tasks are executed, the result is a snapshot.
+     * @return Latencies per (demangled) name of the task type.
+     */
+    [[nodiscard]] std::unordered_map<std::string, TaskLatency> get() const;
+
+private:
+    /**
+     * Latencies of a task type recorded on a channel.
+     */
+    struct Slot
+    {
+        const std::type_info *type{nullptr};
+        TaskLatency latency;
+    };
+
+    /**
+     * Latencies of all task types recorded on a single channel.
+     */
+    struct alignas(64) ChannelLatencies
+    {
+        std::array<Slot, config::max_task_latency_types()> slots{};
+    };
+
+    // Number of channels to monitor.
+    const std::uint16_t _count_channels;
+
+    // Histograms of every channel; nullptr, if not enabled.
+    ChannelLatencies *_channels{nullptr};
+};
+} // namespace mx::tasking::profiling
@@ -0,0 +1,157 @@
+#include "tracer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <fstream>
+#include <iomanip>
+#include <json.hpp>
+#include <mx/memory/global_heap.h>
+#include <mx/system/builtin.h>
+#include <unordered_map>
+
+using namespace mx::tasking::profiling;
+
+Tracer::~Tracer()
+{
+    for (auto *channel_trace : this->_channel_traces)
+    {
+        if (channel_trace != nullptr)
+        {
+            channel_trace->~ChannelTrace();
+            memory::GlobalHeap::free(channel_trace, sizeof(ChannelTrace));
+        }
+    }
+}
+
+ChannelTrace *Tracer::allocate(const std::uint16_t channel_id, const std::uint8_t numa_node_id)
+{
+    this->_channel_traces[channel_id] =
+        new (memory::GlobalHeap::allocate(numa_node_id, sizeof(ChannelTrace))) ChannelTrace();
+    return this->_channel_traces[channel_id];
+}
+
+void Tracer::trace(const std::string &trace_output_file)
+{
+    this->_trace_output_file.emplace(trace_output_file);
+    this->_start_nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    this->_start_timestamp = system::builtin::rdtsc();
+}
+
+void Tracer::stop()
+{
+    if (this->_trace_output_file.has_value() == false)
+    {
+        return;
+    }
+
+    // Time stamps are converted to microseconds by the cycles passed while tracing.
+    const auto end_timestamp = system::builtin::rdtsc();
+    const auto end_nanoseconds =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    const auto cycles_per_microsecond = std::max(double(end_timestamp - this->_start_timestamp) /
+                                                     (double(end_nanoseconds - this->_start_nanoseconds) / 1000.0),
+                                                 1.0);
+    const auto microseconds = [this, cycles_per_microsecond](const std::uint64_t timestamp) {
+        return double(timestamp - this->_start_timestamp) / cycles_per_microsecond;
+    };
+
+    // Names are demangled and escaped once per task type.
+    auto task_names = std::unordered_map<const std::type_info *, std::string>{};
+    const auto task_name = [&task_names](const std::type_info *task_type) -> const std::string & {
+        auto iterator = task_names.find(task_type);
+        if (iterator == task_names.end())
+        {
+            auto status = 0;
+            auto *demangled_name = abi::__cxa_demangle(task_type->name(), nullptr, nullptr, &status);
+            iterator =
+                task_names.emplace(task_type, nlohmann::json(status == 0 ? demangled_name : task_type->name()).dump())
+                    .first;
+            std::free(demangled_name);
+        }
+        return iterator->second;
+    };
+
+    std::ofstream out_file{this->_trace_output_file.value()};
+    out_file << std::fixed << std::setprecision(3) << R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+    auto is_first_event = true;
+    const auto separate = [&out_file, &is_first_event]() -> std::ofstream & {
+        out_file << (is_first_event ? "\n" : ",\n");
+        is_first_event = false;
+        return out_file;
+    };
+
+    auto flow_id = std::uint64_t{0U};
+    for (auto channel_id = 0U; channel_id < this->_channel_traces.size(); ++channel_id)
+    {
+        const auto *channel_trace = this->_channel_traces[channel_id];
+        if (channel_trace == nullptr)
+        {
+            continue;
+        }
+
+        separate() << R"({"name":"thread_name","ph":"M","pid":0,"tid":)" << channel_id
+                   << R"(,"args":{"name":"Channel )" << channel_id << R"("}})";
+
+        channel_trace->for_each([&](const TraceEvent &event) {
+            if (event.start_timestamp < this->_start_timestamp || event.end_timestamp > end_timestamp)
+            {
+                return;
+            }
+
+            if (event.task_type == nullptr)
+            {
+                separate() << R"({"name":")" << (event.buffer_size > 0U ? "fill" : "idle")
+                           << R"(","cat":"fill","ph":"X","pid":0,"tid":)" << channel_id
+                           << R"(,"ts":)" << microseconds(event.start_timestamp)
+                           << R"(,"dur":)" << microseconds(event.end_timestamp) - microseconds(event.start_timestamp)
+                           << R"(,"args":{"tasks":)" << event.buffer_size << "}}";
+                return;
+            }
+
+            separate() << R"({"name":)" << task_name(event.task_type) << R"(,"cat":"task","ph":"X","pid":0,"tid":)"
+                       << channel_id << R"(,"ts":)" << microseconds(event.start_timestamp)
+                       << R"(,"dur":)" << microseconds(event.end_timestamp) - microseconds(event.start_timestamp)
+                       << R"(,"args":{"resource":)";
+            if (event.resource == nullptr)
+            {
+                out_file << "null";
+            }
+            else
+            {
+                out_file << '"' << event.resource << '"';
+            }
+
+            out_file << R"(,"spawner":)";
+            if (event.spawner_channel_id == UNKNOWN_CHANNEL)
+            {
+                out_file << "null}}";
+            }
+            else
+            {
+                out_file << event.spawner_channel_id << "}}";
+            }
+
+            // Tasks crossing channels are connected by an arrow from spawning to starting.
+            if (event.spawner_channel_id != UNKNOWN_CHANNEL && event.spawner_channel_id != channel_id &&
+                event.spawn_timestamp >= this->_start_timestamp && event.spawn_timestamp <= event.start_timestamp)
+            {
+                separate() << R"({"name":"spawn","cat":"spawn","ph":"s","id":)" << flow_id
+                           << R"(,"pid":0,"tid":)" << event.spawner_channel_id
+                           << R"(,"ts":)" << microseconds(event.spawn_timestamp) << "}";
+                separate() << R"({"name":"spawn","cat":"spawn","ph":"f","bp":"e","id":)" << flow_id
+                           << R"(,"pid":0,"tid":)" << channel_id
+                           << R"(,"ts":)" << microseconds(event.start_timestamp) << "}";
+                ++flow_id;
+            }
+        });
+    }
+
+    out_file << "\n]}" << std::endl;
+
+    this->_trace_output_file = std::nullopt;
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <mx/tasking/config.h>
+#include <optional>
+#include <string>
+#include <typeinfo>
+
+namespace mx::tasking::profiling {
+/**
+ * Compact event of a channel: either an executed task or a fill of the task buffer.
+ */
+struct TraceEvent
+{
+    // Type of the executed task; nullptr for filling the task buffer.
+    const std::type_info *task_type;
+
+    // Resource the task was annotated with; nullptr, if none.
+    const void *resource;
+
+    // Time stamps (in cycles) of spawning the task and of starting and ending the execution (or fill).
+    std::uint64_t spawn_timestamp;
+    std::uint64_t start_timestamp;
+    std::uint64_t end_timestamp;
+
+    // Channel the task was spawned on.
+    std::uint16_t spawner_channel_id;
+
+    // Number of tasks in the buffer after the fill.
+    std::uint16_t buffer_size;
+};
+
+/**
+ * Ring buffer holding the latest events of a single channel. Only the
+ * worker of the channel writes events; older events are overwritten.
+ */
+class alignas(64) ChannelTrace
+{
+public:
+    ChannelTrace() noexcept = default;
+    ~ChannelTrace() noexcept = default;
+
+    /**
+     * Records an executed task.
+     * @param task_type Type of the task.
+     * @param resource Resource the task was annotated with; nullptr, if none.
+     * @param spawner_channel_id Channel the task was spawned on.
+     * @param spawn_timestamp Time stamp (in cycles) the task was spawned.
+     * @param start_timestamp Time stamp (in cycles) the execution started.
+     * @param end_timestamp Time stamp (in cycles) the execution ended.
+     */
+    void record_task(const std::type_info &task_type, const void *resource, const std::uint16_t spawner_channel_id,
+                     const std::uint64_t spawn_timestamp, const std::uint64_t start_timestamp,
+                     const std::uint64_t end_timestamp) noexcept
+    {
+        _events[_count_events++ & (config::trace_buffer_size() - 1U)] = TraceEvent{
+            &task_type, resource, spawn_timestamp, start_timestamp, end_timestamp, spawner_channel_id, 0U};
+    }
+
+    /**
+     * Records a fill of the task buffer. Consecutive fills finding no
+     * task (i.e., the worker is idle) are recorded as a single event.
+     * @param start_timestamp Time stamp (in cycles) the fill started.
+     * @param end_timestamp Time stamp (in cycles) the fill ended.
+     * @param buffer_size Number of tasks in the buffer after the fill.
+     */
+    void record_fill(const std::uint64_t start_timestamp, const std::uint64_t end_timestamp,
+                     const std::uint16_t buffer_size) noexcept
+    {
+        if (buffer_size == 0U && _count_events > 0U)
+        {
+            auto &last_event = _events[(_count_events - 1U) & (config::trace_buffer_size() - 1U)];
+            if (last_event.task_type == nullptr && last_event.buffer_size == 0U)
+            {
+                last_event.end_timestamp = end_timestamp;
+                return;
+            }
+        }
+
+        _events[_count_events++ & (config::trace_buffer_size() - 1U)] =
+            TraceEvent{nullptr, nullptr, 0U, start_timestamp, end_timestamp, 0U, buffer_size};
+    }
+
+    /**
+     * Calls the given callback for every held event, from oldest to latest.
+     * @param callback Callback taking a TraceEvent.
+     */
+    template <typename F> void for_each(F &&callback) const
+    {
+        const auto count_events = _count_events;
+        const auto first_event =
+            count_events > config::trace_buffer_size() ? count_events - config::trace_buffer_size() : 0U;
+        for (auto i = first_event; i < count_events; ++i)
+        {
+            callback(_events[i & (config::trace_buffer_size() - 1U)]);
+        }
+    }
+
+private:
+    // Number of events recorded since the start; the latest are held.
+    std::uint64_t _count_events{0U};
+
+    std::array<TraceEvent, config::trace_buffer_size()> _events;
+};
+
+/**
+ * Holds the traces of all channels and writes the events recorded
+ * while tracing in the trace-event format, which is read by Chrome
+ * (chrome://tracing) and Perfetto (ui.perfetto.dev).
+ */
+class Tracer
+{
+public:
+    // Spawner of tasks spawned outside of a channel.
+    inline static constexpr auto UNKNOWN_CHANNEL = std::uint16_t(0xFFFFU);
+
+    Tracer() noexcept = default;
+    ~Tracer();
+
+    /**
+     * Allocates the trace of a channel (requires config::task_tracing()).
+     * @param channel_id Channel.
+     * @param numa_node_id NUMA region of the channel.
+     * @return The trace of the channel.
+     */
+    ChannelTrace *allocate(std::uint16_t channel_id, std::uint8_t numa_node_id);
+
+    /**
+     * Enables tracing and sets the result file. Only events
+     * recorded from now on will be written.
+     * @param trace_output_file File, where the trace should be written to.
+     */
+    void trace(const std::string &trace_output_file);
+
+    /**
+     * Writes the trace to the specified file. Workers must
+     * not record events while writing.
+     */
+    void stop();
+
+private:
+    // File to write the output.
+    std::optional<std::string> _trace_output_file{std::nullopt};
+
+    // Time stamps of starting the trace.
+    std::uint64_t _start_timestamp{0U};
+    std::uint64_t _start_nanoseconds{0U};
+
+    // Trace of every channel; nullptr, if not allocated.
+    std::array<ChannelTrace *, config::max_cores()> _channel_traces{nullptr};
+};
+} // namespace mx::tasking::profiling
@@ -1,14 +1,20 @@
 #pragma once
+#include "prefetch_distance.h"
 #include "scheduler.h"
 #include "task.h"
 #include <iostream>
 #include <memory>
+#include <string>
 #include <mx/memory/dynamic_size_allocator.h>
 #include <mx/memory/fixed_size_allocator.h>
+#include <mx/memory/reclamation/epoch_guard.h>
+#include <mx/memory/statistic.h>
 #include <mx/memory/task_allocator_interface.h>
 #include <mx/resource/builder.h>
 #include <mx/util/core_set.h>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace mx::tasking {
 /**
@@ -22,12 +28,12 @@ public:
     /**
      * Initializes the MxTasking runtime.
      * @param core_set Cores, where the runtime should execute on.
-     * @param prefetch_distance Distance for prefetching.
+     * @param prefetch_distance Distance for prefetching; may be tuned automatically.
      * @param channels_per_core Number of channels per core (more than one enables channel-stealing).
      * @param use_system_allocator Should we use the systems malloc interface or our allocator?
      * @return True, when the runtime was started successfully.
      */
-    static bool init(const util::core_set &core_set, const std::uint16_t prefetch_distance,
+    static bool init(const util::core_set &core_set, const PrefetchDistance prefetch_distance,
                      const bool use_system_allocator)
     {
         // Are we ready to re-initialize the scheduler?
@@ -92,6 +98,13 @@ public:
      */
     static void profile(const std::string &output_file) noexcept { _scheduler->profile(output_file); }
 
+    /**
+     * Start tracing executed tasks (requires config::task_tracing()). The trace
+     * will be written to the given file, when the runtime is stopped.
+     * @param output_file File for the trace, readable by Chrome and Perfetto.
+     */
+    static void trace(const std::string &output_file) noexcept { _scheduler->trace(output_file); }
+
     /**
      * Spawns the given task.
      * @param task Task to be scheduled.
@@ -108,6 +121,16 @@ public:
      */
     static void spawn(TaskInterface &task) noexcept { _scheduler->schedule(task); }
 
+    /**
+     * Forwards the given task to the channel of its annotated resource.
+     * @param task Task to be forwarded.
+     * @param current_channel_id Channel, the task is forwarded from.
+     */
+    static void forward(TaskInterface &task, const std::uint16_t current_channel_id) noexcept
+    {
+        _scheduler->forward(task, current_channel_id);
+    }
+
     /**
      * @return Number of available channels.
      */
@@ -137,6 +160,23 @@ public:
         return new (_task_allocator->allocate(core_id)) T(std::forward<Args>(arguments)...);
     }
 
+    /**
+     * Creates a new task, that will be executed on the given channel. The
+     * task is allocated on the NUMA region of the channel, so that the
+     * executing worker reads (and frees) local memory.
+     * @param core_id Core to allocate memory from.
+     * @param channel_id Channel the task will be executed on.
+     * @param arguments Arguments for the task.
+     * @return The new task.
+     */
+    template <typename T, typename... Args>
+    static T *new_task_for(const std::uint16_t core_id, const std::uint16_t channel_id, Args &&... arguments)
+    {
+        static_assert(sizeof(T) <= config::task_size() && "Task must be leq defined task size.");
+        return new (_task_allocator->allocate(core_id, _scheduler->numa_node_id(channel_id)))
+            T(std::forward<Args>(arguments)...);
+    }
+
     /**
      * Frees a given task.
      * @param core_id Core id to return the memory to.
@@ -148,6 +188,17 @@ public:
         _task_allocator->free(core_id, static_cast<void *>(task));
     }
 
+    /**
+     * Returns task memory freed by the given core to the cores the memory belongs to.
+     * @param core_id Core that freed the memory.
+     */
+    static void flush_task_memory(const std::uint16_t core_id) noexcept { _task_allocator->flush(core_id); }
+
+    /**
+     * Releases memory of the task allocator, that is not used any more.
+     */
+    static void trim_task_memory() noexcept { _task_allocator->trim(); }
+
     /**
      * Creates a resource.
      * @param size Size of the data object.
@@ -161,6 +212,24 @@ public:
         return _resource_builder->build<T>(size, std::move(hint), std::forward<Args>(arguments)...);
     }
 
+    /**
+     * Creates a set of resources with the same size and hint at once, which is
+     * much cheaper than creating every resource separately (e.g., when building
+     * large data structures).
+     *
+     * @param count Number of resources.
+     * @param size Size of every resource.
+     * @param hint Hints for allocation and scheduling.
+     * @param arguments Arguments passed to the constructor of every resource.
+     * @return Pointers to the resources.
+     */
+    template <typename T, typename... Args>
+    static std::vector<resource::ptr> new_resources(const std::size_t count, const std::size_t size,
+                                                    resource::hint &&hint, const Args &... arguments) noexcept
+    {
+        return _resource_builder->build<T>(count, size, std::move(hint), arguments...);
+    }
+
     /**
      * Creates a resource from a given pointer.
      * @param object Pointer to the existing object.
@@ -181,6 +250,73 @@ public:
         _resource_builder->destroy<T>(resource);
     }
 
+    /**
+     * Resolves the replica of a resource (created with a replicated placement)
+     * on the NUMA region of the given channel.
+     * @param resource Resource created by new_resource().
+     * @param channel_id Channel accessing the resource.
+     * @return The replica local to the channel; the resource itself, when it is not replicated.
+     */
+    template <typename T> static T *replica(const resource::ptr resource, const std::uint16_t channel_id) noexcept
+    {
+        return static_cast<T *>(
+            _resource_allocator->replica(resource.get<void>(), _scheduler->numa_node_id(channel_id)));
+    }
+
+    /**
+     * Registers the calling thread, which is not a worker, to read optimistic resources
+     * directly instead of spawning tasks. Reads are protected from memory reclamation
+     * while a memory::reclamation::EpochGuard of the participant is in scope.
+     * @return Participant of the calling thread; not registered, when too many threads take part.
+     */
+    static memory::reclamation::EpochParticipant epoch_participant() noexcept
+    {
+        return memory::reclamation::EpochParticipant{_scheduler->epoch_manager()};
+    }
+
+    /**
+     * Backs all resources created afterward by a heap in the given file, which survives
+     * restarts (see memory::dynamic::PersistentHeap). Instead of rebuilding a data structure
+     * after a restart, its resources are restored (see restore_resource()), starting at the
+     * persistent root. Must be called before the runtime is started.
+     * @param path File of the heap.
+     * @param size Size of the heap.
+     * @return True, when the heap of a previous run was restored.
+     */
+    static bool open_persistent_heap(const std::string &path, const std::size_t size)
+    {
+        return _resource_allocator->open_persistent_heap(path, size);
+    }
+
+    /**
+     * Writes and unmaps the persistent heap; resources on the heap become invalid.
+     */
+    static void close_persistent_heap() { _resource_allocator->close_persistent_heap(); }
+
+    /**
+     * @return Entry point stored in the persistent heap (e.g., the root of a data structure).
+     */
+    static void *persistent_root() noexcept { return _resource_allocator->persistent_root(); }
+
+    /**
+     * Stores the entry point in the persistent heap.
+     * @param root Object on the persistent heap.
+     */
+    static void persistent_root(void *root) noexcept { _resource_allocator->persistent_root(root); }
+
+    /**
+     * Restores a resource of the persistent heap after a restart: the resource is constructed
+     * in place by its restore constructor (see resource::restore_t), which resets the
+     * synchronization, and a channel is assigned.
+     * @param object Object on the persistent heap.
+     * @param hint Hints for scheduling and synchronization.
+     * @return The resource pointer.
+     */
+    template <typename T> static resource::ptr restore_resource(T *object, resource::hint &&hint) noexcept
+    {
+        return _resource_builder->restore<T>(object, std::move(hint));
+    }
+
     static void *allocate(const std::uint8_t numa_node_id, const std::size_t alignment, const std::size_t size) noexcept
     {
         return _resource_allocator->allocate(numa_node_id, alignment, size);
@@ -232,6 +368,57 @@ public:
         return _scheduler->statistic(counter, channel_id);
     }
 
+    /**
+     * Merges the latency histograms of all channels (requires config::task_latency_histograms()).
+     * @return Queueing delay and execution time (in cycles) per task type.
+     */
+    static std::unordered_map<std::string, profiling::TaskLatency> task_latencies()
+    {
+        return _scheduler->task_latencies();
+    }
+
+    /**
+     * Reads the counter of the task allocator for all channels and other threads
+     * (requires memory::config::allocator_statistics()).
+     * @param counter Counter to be read.
+     * @return Aggregated value of all channels and other threads.
+     */
+    static std::uint64_t task_memory_statistic(const memory::Statistic::Counter counter) noexcept
+    {
+        return _task_allocator->statistic().get(counter);
+    }
+
+    /**
+     * Reads the counter of the resource allocator for all channels and other threads
+     * (requires memory::config::allocator_statistics()).
+     * @param counter Counter to be read.
+     * @return Aggregated value of all channels and other threads.
+     */
+    static std::uint64_t resource_memory_statistic(const memory::Statistic::Counter counter) noexcept
+    {
+        return _resource_allocator->statistic().get(counter);
+    }
+
+    /**
+     * Inspects the memory the task allocator holds on a NUMA region.
+     * @param numa_node_id NUMA region.
+     * @return State of the memory on the given NUMA region.
+     */
+    static memory::NodeStatistic task_memory_statistic(const std::uint8_t numa_node_id) noexcept
+    {
+        return _task_allocator->statistic(numa_node_id);
+    }
+
+    /**
+     * Inspects the memory the resource allocator holds on a NUMA region.
+     * @param numa_node_id NUMA region.
+     * @return State of the memory on the given NUMA region.
+     */
+    static memory::NodeStatistic resource_memory_statistic(const std::uint8_t numa_node_id) noexcept
+    {
+        return _resource_allocator->statistic(numa_node_id);
+    }
+
 private:
     // Scheduler to spawn tasks.
     inline static std::unique_ptr<Scheduler> _scheduler = {nullptr};
@@ -255,12 +442,12 @@ class runtime_guard
 {
 public:
     runtime_guard(const bool use_system_allocator, const util::core_set &core_set,
-                  const std::uint16_t prefetch_distance = 0U) noexcept
+                  const PrefetchDistance prefetch_distance = 0U) noexcept
     {
         runtime::init(core_set, prefetch_distance, use_system_allocator);
     }
 
-    runtime_guard(const util::core_set &core_set, const std::uint16_t prefetch_distance = 0U) noexcept
+    runtime_guard(const util::core_set &core_set, const PrefetchDistance prefetch_distance = 0U) noexcept
         : runtime_guard(false, core_set, prefetch_distance)
     {
     }
@@ -1,7 +1,11 @@
 #include "scheduler.h"
+#include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
 #include <mx/memory/global_heap.h>
 #include <mx/synchronization/synchronization.h>
+#include <mx/system/builtin.h>
 #include <mx/system/thread.h>
 #include <mx/system/topology.h>
 #include <thread>
@@ -9,10 +13,11 @@
 
 using namespace mx::tasking;
 
-Scheduler::Scheduler(const mx::util::core_set &core_set, const std::uint16_t prefetch_distance,
+Scheduler::Scheduler(const mx::util::core_set &core_set, const PrefetchDistance prefetch_distance,
                      memory::dynamic::Allocator &resource_allocator) noexcept
     : _core_set(core_set), _count_channels(core_set.size()), _worker({}), _channel_numa_node_map({0U}),
-      _epoch_manager(core_set.size(), resource_allocator, _is_running), _statistic(_count_channels)
+      _epoch_manager(core_set.size(), resource_allocator, _is_running), _statistic(_count_channels),
+      _task_latencies(_count_channels)
 {
     this->_worker.fill(nullptr);
     this->_channel_numa_node_map.fill(0U);
@@ -21,11 +26,18 @@ Scheduler::Scheduler(const mx::util::core_set &core_set, const std::uint16_t pre
     {
         const auto core_id = this->_core_set[worker_id];
         this->_channel_numa_node_map[worker_id] = system::topology::node_id(core_id);
+
+        auto *channel_trace = static_cast<profiling::ChannelTrace *>(nullptr);
+        if constexpr (config::task_tracing())
+        {
+            channel_trace = this->_tracer.allocate(worker_id, this->_channel_numa_node_map[worker_id]);
+        }
+
         this->_worker[worker_id] =
             new (memory::GlobalHeap::allocate(this->_channel_numa_node_map[worker_id], sizeof(Worker)))
                 Worker(worker_id, core_id, this->_channel_numa_node_map[worker_id], this->_is_running,
                        prefetch_distance, this->_epoch_manager[worker_id], this->_epoch_manager.global_epoch(),
-                       this->_statistic);
+                       this->_statistic, this->_task_latencies, channel_trace);
     }
 }
 
@@ -69,6 +81,9 @@ void Scheduler::start_and_wait()
         worker_thread.join();
     }
 
+    // Workers do not record events anymore.
+    this->_tracer.stop();
+
     if constexpr (config::memory_reclamation() != config::None)
     {
         // At this point, no task will execute on any resource;
@@ -80,6 +95,12 @@ void Scheduler::start_and_wait()
 
 void Scheduler::schedule(TaskInterface &task, const std::uint16_t current_channel_id) noexcept
 {
+    if constexpr (config::task_latency_histograms() || config::task_tracing())
+    {
+        task.spawn_timestamp(system::builtin::rdtsc());
+        task.spawner_channel(current_channel_id);
+    }
+
     // Scheduling is based on the annotated resource of the given task.
     if (task.has_resource_annotated())
     {
@@ -89,6 +110,9 @@ void Scheduler::schedule(TaskInterface &task, const std::uint16_t current_channe
         // For performance reasons, we prefer the local (not synchronized) queue
         // whenever possible to spawn the task. The decision is based on the
         // synchronization primitive and the access mode of the task (reader/writer).
+        // Writers of adaptively synchronized resources are kept local like OLFIT
+        // writers, without reading the (remote) resource; the worker forwards
+        // them, when writers are scheduled to the channel of the resource.
         if (Scheduler::keep_task_local(task.is_readonly(), annotated_resource.synchronization_primitive(),
                                        resource_channel_id, current_channel_id))
         {
@@ -109,6 +133,29 @@ void Scheduler::schedule(TaskInterface &task, const std::uint16_t current_channe
         }
     }
 
+    // Tasks working on a set of resources run on the channel of the
+    // scheduled resources, if any; otherwise, they can run everywhere.
+    else if (task.has_resources_annotated())
+    {
+        const auto target_channel_id = Scheduler::resource_set_channel_id(task, current_channel_id);
+        if (target_channel_id == current_channel_id)
+        {
+            this->_worker[current_channel_id]->channel().push_back_local(&task);
+            if constexpr (config::task_statistics())
+            {
+                this->_statistic.increment<profiling::Statistic::ScheduledOnChannel>(current_channel_id);
+            }
+        }
+        else
+        {
+            this->_worker[target_channel_id]->channel().push_back_remote(&task, this->numa_node_id(current_channel_id));
+            if constexpr (config::task_statistics())
+            {
+                this->_statistic.increment<profiling::Statistic::ScheduledOffChannel>(current_channel_id);
+            }
+        }
+    }
+
     // The developer assigned a fixed channel to the task.
     else if (task.has_channel_annotated())
     {
@@ -157,8 +204,24 @@ void Scheduler::schedule(TaskInterface &task, const std::uint16_t current_channe
     }
 }
 
+void Scheduler::forward(TaskInterface &task, const std::uint16_t current_channel_id) noexcept
+{
+    const auto resource_channel_id = task.annotated_resource().channel_id();
+    this->_worker[resource_channel_id]->channel().push_back_remote(&task, this->numa_node_id(current_channel_id));
+    if constexpr (config::task_statistics())
+    {
+        this->_statistic.increment<profiling::Statistic::ScheduledOffChannel>(current_channel_id);
+    }
+}
+
 void Scheduler::schedule(TaskInterface &task) noexcept
 {
+    if constexpr (config::task_latency_histograms() || config::task_tracing())
+    {
+        task.spawn_timestamp(system::builtin::rdtsc());
+        task.spawner_channel(profiling::Tracer::UNKNOWN_CHANNEL);
+    }
+
     if (task.has_resource_annotated())
     {
         const auto &annotated_resource = task.annotated_resource();
@@ -176,6 +239,16 @@ void Scheduler::schedule(TaskInterface &task) noexcept
             this->_statistic.increment<profiling::Statistic::ScheduledOffChannel>(task.annotated_channel());
         }
     }
+    else if (task.has_resources_annotated())
+    {
+        const auto [resources, _] = task.annotated_resources();
+        const auto target_channel_id = Scheduler::resource_set_channel_id(task, resources[0U].channel_id());
+        this->_worker[target_channel_id]->channel().push_back_remote(&task, 0U);
+        if constexpr (config::task_statistics())
+        {
+            this->_statistic.increment<profiling::Statistic::ScheduledOffChannel>(target_channel_id);
+        }
+    }
     else if (task.has_node_annotated())
     {
         // TODO: Select random channel @ node, based on load
@@ -187,12 +260,46 @@ void Scheduler::schedule(TaskInterface &task) noexcept
     }
 }
 
+std::uint16_t Scheduler::resource_set_channel_id(const TaskInterface &task, const std::uint16_t channel_id) noexcept
+{
+    const auto [resources, count] = task.annotated_resources();
+    for (auto i = 0U; i < count; ++i)
+    {
+        const auto primitive = resources[i].synchronization_primitive();
+        if (primitive == synchronization::primitive::ScheduleAll ||
+            (primitive == synchronization::primitive::ScheduleWriter && task.is_readonly() == false))
+        {
+            // Writers of ScheduleWriter resources latch them without compare-exchange, which is only
+            // safe on the channel of the resource. Thus, sets mixing channels are rejected in every build.
+            if (std::all_of(resources, resources + count,
+                            [&task, channel_id = resources[i].channel_id()](const resource::ptr resource) {
+                                return Scheduler::keep_task_local(task.is_readonly(),
+                                                                  resource.synchronization_primitive(),
+                                                                  resource.channel_id(), channel_id);
+                            }) == false)
+            {
+                std::fputs("Scheduled resources of a task have to be mapped to the same channel.\n", stderr);
+                std::abort();
+            }
+            return resources[i].channel_id();
+        }
+    }
+
+    return channel_id;
+}
+
 void Scheduler::reset() noexcept
 {
     this->_statistic.clear();
+    this->_task_latencies.clear();
     this->_epoch_manager.reset();
 }
 
+void Scheduler::trace(const std::string &output_file)
+{
+    this->_tracer.trace(output_file);
+}
+
 void Scheduler::profile(const std::string &output_file)
 {
     this->_profiler.profile(output_file);
@@ -1,5 +1,6 @@
 #pragma once
 #include "channel.h"
+#include "prefetch_distance.h"
 #include "task.h"
 #include "worker.h"
 #include <array>
@@ -14,9 +15,12 @@
 #include <mx/resource/resource.h>
 #include <mx/tasking/profiling/profiling_task.h>
 #include <mx/tasking/profiling/statistic.h>
+#include <mx/tasking/profiling/task_latency.h>
+#include <mx/tasking/profiling/tracer.h>
 #include <mx/util/core_set.h>
 #include <mx/util/random.h>
 #include <string>
+#include <unordered_map>
 
 namespace mx::tasking {
 /**
@@ -26,7 +30,7 @@ namespace mx::tasking {
 class Scheduler
 {
 public:
-    Scheduler(const util::core_set &core_set, std::uint16_t prefetch_distance,
+    Scheduler(const util::core_set &core_set, PrefetchDistance prefetch_distance,
               memory::dynamic::Allocator &resource_allocator) noexcept;
     ~Scheduler() noexcept;
 
@@ -43,6 +47,15 @@ public:
      */
     void schedule(TaskInterface &task) noexcept;
 
+    /**
+     * Forwards a task to the channel of its annotated resource, e.g., a writer
+     * of an adaptively synchronized resource, whose writers are scheduled to
+     * the channel of the resource.
+     * @param task Task to be forwarded.
+     * @param current_channel_id Channel, the task is forwarded from.
+     */
+    void forward(TaskInterface &task, std::uint16_t current_channel_id) noexcept;
+
     /**
      * Starts all worker threads and waits until they finish.
      */
@@ -92,10 +105,12 @@ public:
      * Predicts usage for a given channel.
      * @param channel_id Channel.
      * @param usage Usage to predict.
+     * @param count Number of resources with this usage.
      */
-    void predict_usage(const std::uint16_t channel_id, const resource::hint::expected_access_frequency usage) noexcept
+    void predict_usage(const std::uint16_t channel_id, const resource::hint::expected_access_frequency usage,
+                       const std::uint64_t count = 1U) noexcept
     {
-        _worker[channel_id]->channel().predict_usage(usage);
+        _worker[channel_id]->channel().predict_usage(usage, count);
     }
 
     /**
@@ -120,6 +135,15 @@ public:
         return _worker[channel_id]->channel().has_excessive_usage_prediction();
     }
 
+    /**
+     * @param channel_id Channel.
+     * @return Load of the given channel.
+     */
+    [[nodiscard]] std::uint64_t load(const std::uint16_t channel_id) const noexcept
+    {
+        return _worker[channel_id]->channel().load();
+    }
+
     /**
      * Resets the statistics.
      */
@@ -161,12 +185,28 @@ public:
         }
     }
 
+    /**
+     * Merges the latencies recorded by all channels (requires config::task_latency_histograms()).
+     * @return Queueing delay and execution time per task type.
+     */
+    [[nodiscard]] std::unordered_map<std::string, profiling::TaskLatency> task_latencies() const
+    {
+        return this->_task_latencies.get();
+    }
+
     /**
      * Starts profiling of idle times and specifies the results file.
      * @param output_file File to write idle times after stopping MxTasking.
      */
     void profile(const std::string &output_file);
 
+    /**
+     * Starts tracing executed tasks (requires config::task_tracing()) and specifies
+     * the results file, which is written after the worker threads finished.
+     * @param output_file File to write the trace in the trace-event format.
+     */
+    void trace(const std::string &output_file);
+
     bool operator==(const util::core_set &cores) const noexcept { return _core_set == cores; }
 
     bool operator!=(const util::core_set &cores) const noexcept { return _core_set != cores; }
@@ -194,9 +234,26 @@ private:
     // Profiler for task statistics.
     profiling::Statistic _statistic;
 
+    // Latency histograms of every channel.
+    profiling::TaskLatencies _task_latencies;
+
     // Profiler for idle times.
     profiling::Profiler _profiler{};
 
+    // Traces of executed tasks.
+    profiling::Tracer _tracer{};
+
+    /**
+     * Chooses the channel for a task annotated with a set of resources:
+     * The channel of the resources synchronized by scheduling, if any.
+     *
+     * @param task Task annotated with a set of resources.
+     * @param channel_id Channel to choose when no resource is synchronized by scheduling.
+     * @return Channel the task has to be executed on.
+     */
+    [[nodiscard]] static std::uint16_t resource_set_channel_id(const TaskInterface &task,
+                                                               std::uint16_t channel_id) noexcept;
+
     /**
      * Make a decision whether a task should be scheduled to the local
      * channel or a remote.
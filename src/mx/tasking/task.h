@@ -1,11 +1,16 @@
 #pragma once
 
 #include "config.h"
+#include "prefetch_descriptor.h"
 #include "task_stack.h"
 #include <bitset>
+#include <cassert>
 #include <cstdint>
 #include <functional>
+#include <mx/memory/tagged_ptr.h>
 #include <mx/resource/resource.h>
+#include <mx/system/cache.h>
+#include <type_traits>
 #include <variant>
 
 namespace mx::tasking {
@@ -107,7 +112,8 @@ class TaskInterface
 public:
     using channel = std::uint16_t;
     using node = std::uint8_t;
-    using resource_and_size = std::pair<mx::resource::ptr, std::uint16_t>;
+    using resource_and_prefetch_descriptor = std::pair<mx::resource::ptr, PrefetchDescriptor>;
+    using resource_set = memory::tagged_ptr<const mx::resource::ptr, std::uint16_t>;
 
     constexpr TaskInterface() = default;
     virtual ~TaskInterface() = default;
@@ -121,15 +127,43 @@ public:
      */
     virtual TaskResult execute(std::uint16_t core_id, std::uint16_t channel_id) = 0;
 
+    /**
+     * Will be called by a worker <prefetch distance> tasks before the task gets CPU
+     * time, when the task is annotated with PrefetchDescriptor::make_callback().
+     * The task may prefetch exactly the data it will access during execution
+     * (e.g., by using the annotated resource), but must not access the resource.
+     *
+     * @param level Cache level the data should be prefetched to.
+     * @param access Access (read or write) the data should be prefetched for.
+     */
+    virtual void prefetch(system::cache::level /*level*/, system::cache::access /*access*/) noexcept {}
+
     /**
      * Annotate the task with a resource the task will work on.
      *
      * @param resource Pointer to the resource.
-     * @param size  Size of the resource (that will be prefetched).
+     * @param prefetch_descriptor What will be prefetched for the resource (e.g., the size of the resource).
+     */
+    void annotate(const mx::resource::ptr resource_, const PrefetchDescriptor prefetch_descriptor) noexcept
+    {
+        _annotation.target = std::make_pair(resource_, prefetch_descriptor);
+    }
+
+    /**
+     * Annotate the task with a set of resources the task will work on atomically.
+     * The runtime acquires all resources (in a global order) before execution.
+     * Resources synchronized by scheduling (ScheduleAll, or ScheduleWriter for
+     * writing tasks) have to be mapped to the same channel; the task will be
+     * executed there. Spawning a task whose scheduled resources are mapped to
+     * different channels aborts. The resources are not prefetched.
+     *
+     * @param resources Pointer to the resources; has to stay valid until the task is executed.
+     * @param count Number of resources, at most config::max_annotated_resources().
      */
-    void annotate(const mx::resource::ptr resource_, const std::uint16_t size) noexcept
+    void annotate(const mx::resource::ptr *resources, const std::uint16_t count) noexcept
     {
-        _annotation.target = std::make_pair(resource_, size);
+        assert(count <= config::max_annotated_resources() && "Too many resources annotated.");
+        _annotation.target = resource_set{resources, count};
     }
 
     /**
@@ -165,15 +199,24 @@ public:
      */
     [[nodiscard]] mx::resource::ptr annotated_resource() const noexcept
     {
-        return std::get<0>(std::get<resource_and_size>(_annotation.target));
+        return std::get<0>(std::get<resource_and_prefetch_descriptor>(_annotation.target));
     }
 
     /**
-     * @return The annotated resource size.
+     * @return The descriptor of what will be prefetched for the annotated resource.
      */
-    [[nodiscard]] std::uint16_t annotated_resource_size() const noexcept
+    [[nodiscard]] PrefetchDescriptor annotated_prefetch_descriptor() const noexcept
     {
-        return std::get<1>(std::get<resource_and_size>(_annotation.target));
+        return std::get<1>(std::get<resource_and_prefetch_descriptor>(_annotation.target));
+    }
+
+    /**
+     * @return The annotated set of resources and its size.
+     */
+    [[nodiscard]] std::pair<const mx::resource::ptr *, std::uint16_t> annotated_resources() const noexcept
+    {
+        const auto resources = std::get<resource_set>(_annotation.target);
+        return std::make_pair(resources.get(), resources.info());
     }
 
     /**
@@ -201,7 +244,15 @@ public:
      */
     [[nodiscard]] bool has_resource_annotated() const noexcept
     {
-        return std::holds_alternative<resource_and_size>(_annotation.target);
+        return std::holds_alternative<resource_and_prefetch_descriptor>(_annotation.target);
+    }
+
+    /**
+     * @return True, when the task has a set of resources annotated.
+     */
+    [[nodiscard]] bool has_resources_annotated() const noexcept
+    {
+        return std::holds_alternative<resource_set>(_annotation.target);
     }
 
     /**
@@ -228,6 +279,35 @@ public:
      */
     void next(TaskInterface *next) noexcept { _next = next; }
 
+    /**
+     * @return Time stamp (in cycles) the task was spawned at
+     *         (requires config::task_latency_histograms() or config::task_tracing()).
+     */
+    [[nodiscard]] std::uint64_t spawn_timestamp() const noexcept { return _spawn_timestamp; }
+
+    /**
+     * Set the time stamp the task was spawned at.
+     * @param timestamp Time stamp in cycles.
+     */
+    void spawn_timestamp(const std::uint64_t timestamp) noexcept
+    {
+        _spawn_timestamp = decltype(_spawn_timestamp)(timestamp);
+    }
+
+    /**
+     * @return Channel the task was spawned on (requires config::task_tracing()).
+     */
+    [[nodiscard]] channel spawner_channel() const noexcept { return _spawner_channel; }
+
+    /**
+     * Set the channel the task was spawned on.
+     * @param channel_id Channel.
+     */
+    void spawner_channel(const channel channel_id) noexcept
+    {
+        _spawner_channel = decltype(_spawner_channel)(channel_id);
+    }
+
 private:
     /**
      * Annotation of a task.
@@ -248,7 +328,7 @@ private:
         };
 
         // Target the task will run on.
-        std::variant<channel, node, resource_and_size, bool> target{false};
+        std::variant<channel, node, resource_and_prefetch_descriptor, resource_set, bool> target{false};
     } __attribute__((packed));
 
     // Pointer for next task in queue.
@@ -256,6 +336,13 @@ private:
 
     // Tasks annotations.
     annotation _annotation;
+
+    // Channel and time stamp of spawning the task. Without latency histograms
+    // and tracing, these are single bytes that fit into the padding behind
+    // the annotation.
+    std::conditional_t<config::task_tracing(), channel, std::uint8_t> _spawner_channel{0U};
+    std::conditional_t<config::task_latency_histograms() || config::task_tracing(), std::uint64_t, std::uint8_t>
+        _spawn_timestamp{0U};
 };
 
 class StopTaskingTask final : public TaskInterface
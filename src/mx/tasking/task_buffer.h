@@ -23,6 +23,7 @@ private:
         ~Slot() noexcept = default;
 
         void task(TaskInterface *task) noexcept { _task = task; }
+        [[nodiscard]] TaskInterface *task() const noexcept { return _task; }
         [[nodiscard]] TaskInterface *consume_task() noexcept { return std::exchange(_task, nullptr); }
 
         void prefetch() noexcept { _prefetch_slot(); }
@@ -65,11 +66,28 @@ public:
      */
     [[nodiscard]] std::uint16_t available_slots() const noexcept { return S - size(); }
 
+    /**
+     * @return Distance of prefetched tasks.
+     */
+    [[nodiscard]] std::uint8_t prefetch_distance() const noexcept { return _prefetch_distance; }
+
+    /**
+     * Updates the prefetch distance. The new distance will be applied to tasks
+     * filled into the buffer from now on.
+     * @param prefetch_distance New distance of prefetched tasks.
+     */
+    void prefetch_distance(const std::uint8_t prefetch_distance) noexcept { _prefetch_distance = prefetch_distance; }
+
     /**
      * @return The next task in the buffer; the slot will be available after.
      */
     TaskInterface *next() noexcept;
 
+    /**
+     * @return The next task in the buffer without taking it out; nullptr, when the buffer is empty.
+     */
+    [[nodiscard]] TaskInterface *peek() const noexcept { return _buffer[_head].task(); }
+
     /**
      * Takes out tasks from the given queue and inserts them into the buffer.
      * @param from_queue Queue to take tasks from.
@@ -80,7 +98,7 @@ public:
 
 private:
     // Prefetch distance.
-    const std::uint8_t _prefetch_distance;
+    std::uint8_t _prefetch_distance;
 
     // Index of the first element in the buffer.
     std::uint16_t _head{0U};
@@ -3,6 +3,8 @@
 #include "runtime.h"
 #include "task.h"
 #include <cassert>
+#include <mx/memory/statistic.h>
+#include <mx/resource/resource_set_latch.h>
 #include <mx/system/builtin.h>
 #include <mx/system/topology.h>
 #include <mx/util/random.h>
@@ -10,12 +12,14 @@
 using namespace mx::tasking;
 
 Worker::Worker(const std::uint16_t id, const std::uint16_t target_core_id, const std::uint16_t target_numa_node_id,
-               const util::maybe_atomic<bool> &is_running, const std::uint16_t prefetch_distance,
+               const util::maybe_atomic<bool> &is_running, const PrefetchDistance prefetch_distance,
                memory::reclamation::LocalEpoch &local_epoch,
-               const std::atomic<memory::reclamation::epoch_t> &global_epoch, profiling::Statistic &statistic) noexcept
-    : _target_core_id(target_core_id), _prefetch_distance(prefetch_distance),
-      _channel(id, target_numa_node_id, prefetch_distance), _local_epoch(local_epoch), _global_epoch(global_epoch),
-      _statistic(statistic), _is_running(is_running)
+               const std::atomic<memory::reclamation::epoch_t> &global_epoch, profiling::Statistic &statistic,
+               profiling::TaskLatencies &task_latencies, profiling::ChannelTrace *channel_trace) noexcept
+    : _target_core_id(target_core_id), _prefetch_distance(prefetch_distance.initial()),
+      _prefetch_distance_tuner(prefetch_distance), _channel(id, target_numa_node_id, prefetch_distance.initial()),
+      _local_epoch(local_epoch), _global_epoch(global_epoch), _statistic(statistic), _task_latencies(task_latencies),
+      _channel_trace(channel_trace), _is_running(is_running)
 {
 }
 
@@ -31,18 +35,38 @@ void Worker::execute()
     assert(this->_target_core_id == core_id && "Worker not pinned to correct core.");
     const auto channel_id = this->_channel.id();
 
+    // Allocations of this thread are counted for the channel.
+    if constexpr (memory::config::allocator_statistics())
+    {
+        memory::Statistic::bind(channel_id);
+    }
+
     while (this->_is_running)
     {
         if constexpr (config::memory_reclamation() == config::UpdateEpochPeriodically)
         {
             this->_local_epoch.enter(this->_global_epoch);
         }
+        else if constexpr (config::memory_reclamation() == config::QuiescentState)
+        {
+            // Idle workers pass quiescent states on every fill.
+            this->_local_epoch.quiescent(this->_global_epoch);
+        }
 
-        this->_channel_size = this->_channel.fill();
+        this->fill(channel_id);
 
-        if constexpr (config::task_statistics())
+        // Idle workers return task memory of other cores, that was
+        // freed here but did not fill a batch for its home core.
+        if (this->_channel_size == 0U)
         {
-            this->_statistic.increment<profiling::Statistic::Fill>(channel_id);
+            runtime::flush_task_memory(core_id);
+        }
+
+        // Cycles spent while the channel was empty should
+        // not be accounted for tuning the prefetch distance.
+        if (this->_prefetch_distance_tuner.is_enabled() && this->_channel_size > 0)
+        {
+            this->_prefetch_distance_tuner.restart();
         }
 
         while ((task = this->_channel.next()) != nullptr)
@@ -52,71 +76,165 @@ void Worker::execute()
             // empty slots in the prefetch-buffer.
             if (--this->_channel_size <= this->_prefetch_distance)
             {
-                if constexpr (config::memory_reclamation() == config::UpdateEpochPeriodically)
+                // The worker was busy since the last fill; the sample
+                // is used to adjust the prefetch distance before the
+                // buffer is re-filled with tasks.
+                if (this->_prefetch_distance_tuner.is_enabled() && this->_prefetch_distance_tuner.update())
                 {
-                    this->_local_epoch.enter(this->_global_epoch);
+                    this->_prefetch_distance = this->_prefetch_distance_tuner.distance();
+                    this->_channel.prefetch_distance(this->_prefetch_distance_tuner.distance());
                 }
 
-                this->_channel_size = this->_channel.fill();
-                if constexpr (config::task_statistics())
+                if constexpr (config::memory_reclamation() == config::UpdateEpochPeriodically)
                 {
-                    this->_statistic.increment<profiling::Statistic::Fill>(channel_id);
+                    this->_local_epoch.enter(this->_global_epoch);
                 }
-            }
 
-            if constexpr (config::task_statistics())
-            {
-                this->_statistic.increment<profiling::Statistic::Executed>(channel_id);
-                if (task->has_resource_annotated())
-                {
-                    if (task->is_readonly())
-                    {
-                        this->_statistic.increment<profiling::Statistic::ExecutedReader>(channel_id);
-                    }
-                    else
-                    {
-                        this->_statistic.increment<profiling::Statistic::ExecutedWriter>(channel_id);
-                    }
-                }
+                this->fill(channel_id);
             }
 
-            // Based on the annotated resource and its synchronization
-            // primitive, we choose the fitting execution context.
-            auto result = TaskResult{};
-            switch (Worker::synchronization_primitive(task))
+            this->run(core_id, channel_id, task, false);
+
+            if constexpr (config::memory_reclamation() == config::QuiescentState)
             {
-            case synchronization::primitive::ScheduleWriter:
-                result = this->execute_optimistic(core_id, channel_id, task);
-                break;
-            case synchronization::primitive::OLFIT:
-                result = this->execute_olfit(core_id, channel_id, task);
-                break;
-            case synchronization::primitive::ScheduleAll:
-            case synchronization::primitive::None:
-                result = task->execute(core_id, channel_id);
-                break;
-            case synchronization::primitive::ReaderWriterLatch:
-                result = Worker::execute_reader_writer_latched(core_id, channel_id, task);
-                break;
-            case synchronization::primitive::ExclusiveLatch:
-                result = Worker::execute_exclusive_latched(core_id, channel_id, task);
-                break;
+                this->_local_epoch.quiescent(this->_global_epoch);
             }
+        }
+    }
+}
 
-            // The task-chain may be finished at time the
-            // task has no successor. Otherwise, we spawn
-            // the successor task.
-            if (result.has_successor())
+void Worker::run(const std::uint16_t core_id, const std::uint16_t channel_id, TaskInterface *const task,
+                 const bool is_batched_writer)
+{
+    if (this->_prefetch_distance_tuner.is_enabled())
+    {
+        this->_prefetch_distance_tuner.executed();
+    }
+
+    if constexpr (config::task_statistics())
+    {
+        this->_statistic.increment<profiling::Statistic::Executed>(channel_id);
+        if (task->has_resource_annotated())
+        {
+            if (task->is_readonly())
             {
-                runtime::spawn(*static_cast<TaskInterface *>(result), channel_id);
+                this->_statistic.increment<profiling::Statistic::ExecutedReader>(channel_id);
             }
-
-            if (result.is_remove())
+            else
             {
-                runtime::delete_task(core_id, task);
+                this->_statistic.increment<profiling::Statistic::ExecutedWriter>(channel_id);
             }
         }
     }
+
+    [[maybe_unused]] auto record = ExecutionRecord{};
+    if constexpr (IS_RECORDING_EXECUTIONS)
+    {
+        record = Worker::begin_record(task);
+    }
+
+    // Based on the annotated resource and its synchronization
+    // primitive, we choose the fitting execution context. Batched
+    // writers run within the version latch of a preceding writer.
+    auto result = TaskResult{};
+    if (is_batched_writer)
+    {
+        result = task->execute(core_id, channel_id);
+    }
+    else if (task->has_resources_annotated())
+    {
+        result = this->execute_resource_set(core_id, channel_id, task);
+    }
+    else
+    {
+        switch (Worker::synchronization_primitive(task))
+        {
+        case synchronization::primitive::ScheduleWriter:
+            result = this->execute_optimistic(core_id, channel_id, task);
+            break;
+        case synchronization::primitive::OLFIT:
+            result = this->execute_olfit(core_id, channel_id, task);
+            break;
+        case synchronization::primitive::Adaptive:
+            result = this->execute_adaptive(core_id, channel_id, task);
+            break;
+        case synchronization::primitive::ScheduleAll:
+        case synchronization::primitive::None:
+            result = task->execute(core_id, channel_id);
+            break;
+        case synchronization::primitive::ReaderWriterLatch:
+            result = Worker::execute_reader_writer_latched(core_id, channel_id, task);
+            break;
+        case synchronization::primitive::ExclusiveLatch:
+            result = Worker::execute_exclusive_latched(core_id, channel_id, task);
+            break;
+        case synchronization::primitive::MCSLatch:
+            result = Worker::execute_mcs_latched(core_id, channel_id, task);
+            break;
+        case synchronization::primitive::CohortLatch:
+            result = this->execute_cohort_latched(core_id, channel_id, task);
+            break;
+        }
+    }
+
+    if constexpr (IS_RECORDING_EXECUTIONS)
+    {
+        this->end_record(channel_id, record);
+    }
+
+    Worker::handle_result(core_id, channel_id, task, result);
+}
+
+void Worker::fill(const std::uint16_t channel_id)
+{
+    [[maybe_unused]] const auto start_timestamp = config::task_tracing() ? system::builtin::rdtsc() : 0U;
+
+    this->_channel_size = this->_channel.fill();
+
+    if constexpr (config::task_tracing())
+    {
+        this->_channel_trace->record_fill(start_timestamp, system::builtin::rdtsc(),
+                                          std::uint16_t(this->_channel_size));
+    }
+
+    if constexpr (config::task_statistics())
+    {
+        this->_statistic.increment<profiling::Statistic::Fill>(channel_id);
+    }
+}
+
+void Worker::end_record(const std::uint16_t channel_id, const ExecutionRecord &record) noexcept
+{
+    const auto end_timestamp = system::builtin::rdtsc();
+
+    if constexpr (config::task_latency_histograms())
+    {
+        this->_task_latencies.record(channel_id, *record.task_type, record.spawn_timestamp, record.start_timestamp,
+                                     end_timestamp);
+    }
+
+    if constexpr (config::task_tracing())
+    {
+        this->_channel_trace->record_task(*record.task_type, record.resource, record.spawner_channel_id,
+                                          record.spawn_timestamp, record.start_timestamp, end_timestamp);
+    }
+}
+
+void Worker::handle_result(const std::uint16_t core_id, const std::uint16_t channel_id, TaskInterface *const task,
+                           const TaskResult result)
+{
+    // The task-chain may be finished at time the
+    // task has no successor. Otherwise, we spawn
+    // the successor task.
+    if (result.has_successor())
+    {
+        runtime::spawn(*static_cast<TaskInterface *>(result), channel_id);
+    }
+
+    if (result.is_remove())
+    {
+        runtime::delete_task(core_id, task);
+    }
 }
 
 TaskResult Worker::execute_exclusive_latched(const std::uint16_t core_id, const std::uint16_t channel_id,
@@ -128,6 +246,24 @@ TaskResult Worker::execute_exclusive_latched(const std::uint16_t core_id, const
     return task->execute(core_id, channel_id);
 }
 
+TaskResult Worker::execute_mcs_latched(const std::uint16_t core_id, const std::uint16_t channel_id,
+                                       mx::tasking::TaskInterface *const task)
+{
+    auto *resource = resource::ptr_cast<resource::ResourceInterface>(task->annotated_resource());
+
+    resource::ResourceInterface::scoped_mcs_latch _{resource};
+    return task->execute(core_id, channel_id);
+}
+
+TaskResult Worker::execute_cohort_latched(const std::uint16_t core_id, const std::uint16_t channel_id,
+                                          mx::tasking::TaskInterface *const task)
+{
+    auto *resource = resource::ptr_cast<resource::ResourceInterface>(task->annotated_resource());
+
+    resource::ResourceInterface::scoped_cohort_latch _{resource, this->_channel.numa_node_id()};
+    return task->execute(core_id, channel_id);
+}
+
 TaskResult Worker::execute_reader_writer_latched(const std::uint16_t core_id, const std::uint16_t channel_id,
                                                  mx::tasking::TaskInterface *const task)
 {
@@ -136,12 +272,12 @@ TaskResult Worker::execute_reader_writer_latched(const std::uint16_t core_id, co
     // Reader do only need to acquire a "read-only" latch.
     if (task->is_readonly())
     {
-        resource::ResourceInterface::scoped_rw_latch<false> _{resource};
+        resource::ResourceInterface::scoped_reader_latch _{resource, channel_id};
         return task->execute(core_id, channel_id);
     }
 
     {
-        resource::ResourceInterface::scoped_rw_latch<true> _{resource};
+        resource::ResourceInterface::scoped_writer_latch _{resource};
         return task->execute(core_id, channel_id);
     }
 }
@@ -149,7 +285,10 @@ TaskResult Worker::execute_reader_writer_latched(const std::uint16_t core_id, co
 TaskResult Worker::execute_optimistic(const std::uint16_t core_id, const std::uint16_t channel_id,
                                       mx::tasking::TaskInterface *const task)
 {
-    auto *optimistic_resource = resource::ptr_cast<resource::ResourceInterface>(task->annotated_resource());
+    // The resource is captured before executing, since tasks may
+    // re-annotate themselves (e.g., to a sibling node) while executing.
+    const auto resource = task->annotated_resource();
+    auto *optimistic_resource = resource::ptr_cast<resource::ResourceInterface>(resource);
 
     if (task->is_readonly())
     {
@@ -157,9 +296,9 @@ TaskResult Worker::execute_optimistic(const std::uint16_t core_id, const std::ui
         // we need to validate the version of the resource. This
         // comes along with saving the tasks state on a stack and
         // re-running the task, whenever the version check failed.
-        if (task->annotated_resource().channel_id() != channel_id)
+        if (resource.channel_id() != channel_id)
         {
-            return this->execute_optimistic_read(core_id, channel_id, optimistic_resource, task);
+            return this->execute_optimistic_read(core_id, channel_id, optimistic_resource, task, false);
         }
 
         // Whenever the task is executed at the same channel
@@ -174,7 +313,35 @@ TaskResult Worker::execute_optimistic(const std::uint16_t core_id, const std::ui
     // fetch_add operation, because writers are serialized on the channel.
     {
         resource::ResourceInterface::scoped_optimistic_latch _{optimistic_resource};
-        return task->execute(core_id, channel_id);
+        const auto result = task->execute(core_id, channel_id);
+        this->execute_batched_writers(core_id, channel_id, resource);
+        return result;
+    }
+}
+
+void Worker::execute_batched_writers(const std::uint16_t core_id, const std::uint16_t channel_id,
+                                     const resource::ptr resource)
+{
+    // Consecutive writers of the same resource, waiting in the buffer, are
+    // executed within the version window of the first writer. Thus, remote
+    // readers see one modification per batch instead of one per writer.
+    // The batch ends before the buffer falls under the prefetch distance:
+    // re-filling the buffer and entering the epoch is left to the execution
+    // loop, after the latch is released. Otherwise, a resource removed by a
+    // batched writer could be reclaimed before its latch is released.
+    for (auto i = 1U; i < config::max_batched_writers() && this->_channel_size - 1 > this->_prefetch_distance; ++i)
+    {
+        auto *task = this->_channel.peek();
+        if (task == nullptr || task->is_readonly() || task->has_resource_annotated() == false ||
+            task->annotated_resource() != resource)
+        {
+            return;
+        }
+
+        static_cast<void>(this->_channel.next());
+        --this->_channel_size;
+
+        this->run(core_id, channel_id, task, true);
     }
 }
 
@@ -184,7 +351,7 @@ TaskResult Worker::execute_olfit(const std::uint16_t core_id, const std::uint16_
 
     if (task->is_readonly())
     {
-        return this->execute_optimistic_read(core_id, channel_id, optimistic_resource, task);
+        return this->execute_optimistic_read(core_id, channel_id, optimistic_resource, task, false);
     }
 
     // Writers, however, need to acquire the version to tell readers, that
@@ -197,8 +364,99 @@ TaskResult Worker::execute_olfit(const std::uint16_t core_id, const std::uint16_
     }
 }
 
+TaskResult Worker::execute_adaptive(const std::uint16_t core_id, const std::uint16_t channel_id,
+                                    TaskInterface *const task)
+{
+    auto *adaptive_resource = resource::ptr_cast<resource::ResourceInterface>(task->annotated_resource());
+    auto &adaptive_synchronization = adaptive_resource->adaptive_synchronization();
+
+    // The scheduler spawns writers like OLFIT writers, without reading the
+    // state of the (remote) resource. When writers of the resource are
+    // scheduled to its channel, they are forwarded from here.
+    if (task->is_readonly() == false &&
+        adaptive_synchronization.current() == synchronization::primitive::ScheduleWriter &&
+        task->annotated_resource().channel_id() != channel_id)
+    {
+        runtime::forward(*task, channel_id);
+        return TaskResult::make_null();
+    }
+
+    // Only a random share of the accesses is sampled to keep the shared counters
+    // of the resource cold. Drawing randomly (instead of counting accesses of the
+    // worker) samples every resource at the same rate, independent of the order
+    // the worker accesses resources.
+    const auto is_sampled =
+        this->_adaptive_synchronization_sampler.next(config::adaptive_synchronization_sample_rate()) == 0U;
+
+    // Readers do not know whether writers are scheduled to the channel
+    // of the resource or not; thus, they always validate the version.
+    if (task->is_readonly())
+    {
+        return this->execute_optimistic_read(core_id, channel_id, adaptive_resource, task, is_sampled);
+    }
+
+    // Writers always use compare xchg, because they may run on every
+    // channel while (and shortly after) switching the primitive.
+    const auto spins = adaptive_resource->acquire_optimistic_latch();
+    if (is_sampled)
+    {
+        adaptive_synchronization.sample_write(spins);
+    }
+
+    const auto result = task->execute(core_id, channel_id);
+    adaptive_resource->release_optimistic_latch();
+    return result;
+}
+
+TaskResult Worker::execute_resource_set(const std::uint16_t core_id, const std::uint16_t channel_id,
+                                        TaskInterface *const task)
+{
+    const auto [resources, count] = task->annotated_resources();
+    auto latch = resource::ResourceSetLatch{resources, count, task->is_readonly(), channel_id,
+                                            this->_channel.numa_node_id()};
+
+    // Writers acquire all resources exclusively and succeed at first try.
+    if (task->is_readonly() == false)
+    {
+        latch.lock();
+        const auto result = task->execute(core_id, channel_id);
+        latch.unlock();
+        return result;
+    }
+
+    if constexpr (config::memory_reclamation() == config::UpdateEpochOnRead)
+    {
+        this->_local_epoch.enter(this->_global_epoch);
+    }
+
+    // Readers may read some resources optimistically; whenever one of
+    // them was modified, all resources are released and the task is
+    // restored and re-run.
+    this->_task_stack.save(task);
+
+    do
+    {
+        latch.lock();
+        const auto result = task->execute(core_id, channel_id);
+        const auto is_valid = latch.is_valid();
+        latch.unlock();
+
+        if (is_valid)
+        {
+            if constexpr (config::memory_reclamation() == config::UpdateEpochOnRead)
+            {
+                this->_local_epoch.leave();
+            }
+            return result;
+        }
+
+        this->_task_stack.restore(task);
+    } while (true);
+}
+
 TaskResult Worker::execute_optimistic_read(const std::uint16_t core_id, const std::uint16_t channel_id,
-                                           resource::ResourceInterface *optimistic_resource, TaskInterface *const task)
+                                           resource::ResourceInterface *optimistic_resource, TaskInterface *const task,
+                                           const bool is_sampled)
 {
     if constexpr (config::memory_reclamation() == config::UpdateEpochOnRead)
     {
@@ -210,6 +468,7 @@ TaskResult Worker::execute_optimistic_read(const std::uint16_t core_id, const st
     // the task was maybe modified.
     this->_task_stack.save(task);
 
+    auto aborts = std::uint32_t{0U};
     do
     {
         const auto version = optimistic_resource->version();
@@ -217,6 +476,11 @@ TaskResult Worker::execute_optimistic_read(const std::uint16_t core_id, const st
 
         if (optimistic_resource->is_version_valid(version))
         {
+            if (is_sampled)
+            {
+                optimistic_resource->adaptive_synchronization().sample_read(aborts);
+            }
+
             if constexpr (config::memory_reclamation() == config::UpdateEpochOnRead)
             {
                 this->_local_epoch.leave();
@@ -226,6 +490,7 @@ TaskResult Worker::execute_optimistic_read(const std::uint16_t core_id, const st
 
         // At this point, the version check failed and we need
         // to re-run the read operation.
+        ++aborts;
         this->_task_stack.restore(task);
     } while (true);
 }
\ No newline at end of file
@@ -2,14 +2,20 @@
 
 #include "channel.h"
 #include "config.h"
+#include "prefetch_distance.h"
 #include "profiling/statistic.h"
+#include "profiling/task_latency.h"
+#include "profiling/tracer.h"
 #include "task.h"
 #include "task_stack.h"
 #include <atomic>
 #include <cstddef>
 #include <memory>
 #include <mx/memory/reclamation/epoch_manager.h>
+#include <mx/system/builtin.h>
 #include <mx/util/maybe_atomic.h>
+#include <mx/util/random.h>
+#include <typeinfo>
 #include <variant>
 #include <vector>
 
@@ -21,9 +27,10 @@ class alignas(64) Worker
 {
 public:
     Worker(std::uint16_t id, std::uint16_t target_core_id, std::uint16_t target_numa_node_id,
-           const util::maybe_atomic<bool> &is_running, std::uint16_t prefetch_distance,
+           const util::maybe_atomic<bool> &is_running, PrefetchDistance prefetch_distance,
            memory::reclamation::LocalEpoch &local_epoch, const std::atomic<memory::reclamation::epoch_t> &global_epoch,
-           profiling::Statistic &statistic) noexcept;
+           profiling::Statistic &statistic, profiling::TaskLatencies &task_latencies,
+           profiling::ChannelTrace *channel_trace) noexcept;
 
     ~Worker() noexcept = default;
 
@@ -41,14 +48,36 @@ public:
     [[nodiscard]] const Channel &channel() const noexcept { return _channel; }
 
 private:
+    // Executed tasks are timed for latency histograms and traces.
+    inline static constexpr auto IS_RECORDING_EXECUTIONS = config::task_latency_histograms() || config::task_tracing();
+
+    /**
+     * Execution of a task as recorded for latency histograms and traces. Taken
+     * before execution, since the task may be re-used (and re-spawned) or freed.
+     */
+    struct ExecutionRecord
+    {
+        const std::type_info *task_type{nullptr};
+        const void *resource{nullptr};
+        std::uint64_t spawn_timestamp{0U};
+        std::uint64_t start_timestamp{0U};
+        std::uint16_t spawner_channel_id{0U};
+    };
+
     // Id of the logical core.
     const std::uint16_t _target_core_id;
 
     // Distance of prefetching tasks.
-    const std::uint16_t _prefetch_distance;
+    std::uint16_t _prefetch_distance;
+
+    // Tunes the prefetch distance at runtime, if enabled.
+    PrefetchDistanceTuner _prefetch_distance_tuner;
 
     std::int32_t _channel_size{0U};
 
+    // Decides which accesses to adaptively synchronized resources are sampled.
+    util::Random _adaptive_synchronization_sampler;
+
     // Stack for persisting tasks in optimistic execution. Optimistically
     // executed tasks may fail and be restored after execution.
     alignas(64) TaskStack _task_stack;
@@ -65,9 +94,51 @@ private:
     // Statistics container.
     profiling::Statistic &_statistic;
 
+    // Latency histograms, recorded if enabled.
+    profiling::TaskLatencies &_task_latencies;
+
+    // Trace of this channel, recorded if enabled.
+    profiling::ChannelTrace *_channel_trace;
+
     // Flag for "running" state of MxTasking.
     const util::maybe_atomic<bool> &_is_running;
 
+    /**
+     * Executes a task taken from the task buffer, using the execution context
+     * of its synchronization primitive. Besides, accounts the execution for
+     * tuning the prefetch distance, statistics, and recording.
+     * @param core_id Id of the core.
+     * @param channel_id Id of the channel.
+     * @param task Task to be executed.
+     * @param is_batched_writer True, when the task is a writer executed within the latch of a preceding writer.
+     */
+    void run(std::uint16_t core_id, std::uint16_t channel_id, TaskInterface *task, bool is_batched_writer);
+
+    /**
+     * Fills the task buffer from the queues of the channel.
+     * @param channel_id Id of the channel.
+     */
+    void fill(std::uint16_t channel_id);
+
+    /**
+     * Starts recording the execution of a task.
+     * @param task Task to be executed.
+     * @return Record of the execution.
+     */
+    [[nodiscard]] static ExecutionRecord begin_record(const TaskInterface *task) noexcept
+    {
+        const auto *resource = task->has_resource_annotated() ? task->annotated_resource().get() : nullptr;
+        return ExecutionRecord{&typeid(*task), resource, task->spawn_timestamp(), system::builtin::rdtsc(),
+                               task->spawner_channel()};
+    }
+
+    /**
+     * Ends recording the execution of a task and adds it to the latency histograms and the trace.
+     * @param channel_id Id of the channel.
+     * @param record Record of the execution.
+     */
+    void end_record(std::uint16_t channel_id, const ExecutionRecord &record) noexcept;
+
     /**
      * Analyzes the given task and chooses the execution method regarding synchronization.
      * @param task Task to be executed.
@@ -88,6 +159,24 @@ private:
      */
     static TaskResult execute_exclusive_latched(std::uint16_t core_id, std::uint16_t channel_id, TaskInterface *task);
 
+    /**
+     * Executes a task with a queue-based (MCS) latch.
+     * @param core_id Id of the core.
+     * @param channel_id Id of the channel.
+     * @param task Task to be executed.
+     * @return Task to be scheduled after execution.
+     */
+    static TaskResult execute_mcs_latched(std::uint16_t core_id, std::uint16_t channel_id, TaskInterface *task);
+
+    /**
+     * Executes a task with a NUMA-aware cohort latch.
+     * @param core_id Id of the core.
+     * @param channel_id Id of the channel.
+     * @param task Task to be executed.
+     * @return Task to be scheduled after execution.
+     */
+    TaskResult execute_cohort_latched(std::uint16_t core_id, std::uint16_t channel_id, TaskInterface *task);
+
     /**
      * Executes a task with a reader/writer latch.
      * @param core_id Id of the core.
@@ -107,6 +196,25 @@ private:
      */
     TaskResult execute_optimistic(std::uint16_t core_id, std::uint16_t channel_id, TaskInterface *task);
 
+    /**
+     * Executes writers of the given ScheduleWriter-resource that wait at
+     * the head of the task buffer. The caller holds the version latch.
+     * @param core_id Id of the core.
+     * @param channel_id Id of the channel.
+     * @param resource Resource written by the batch.
+     */
+    void execute_batched_writers(std::uint16_t core_id, std::uint16_t channel_id, resource::ptr resource);
+
+    /**
+     * Spawns the successor of an executed task and deletes the task, if requested.
+     * @param core_id Id of the core.
+     * @param channel_id Id of the channel.
+     * @param task Executed task.
+     * @param result Result of the execution.
+     */
+    static void handle_result(std::uint16_t core_id, std::uint16_t channel_id, TaskInterface *task,
+                              TaskResult result);
+
     /**
      * Executes the task using olfit protocol.
      * @param core_id Id of the core.
@@ -116,15 +224,36 @@ private:
      */
     TaskResult execute_olfit(std::uint16_t core_id, std::uint16_t channel_id, TaskInterface *task);
 
+    /**
+     * Executes the task on an adaptively synchronized resource, using
+     * olfit for writers and sampling the accesses of the resource.
+     * @param core_id Id of the core.
+     * @param channel_id Id of the channel.
+     * @param task Task to be executed.
+     * @return Task to be scheduled after execution.
+     */
+    TaskResult execute_adaptive(std::uint16_t core_id, std::uint16_t channel_id, TaskInterface *task);
+
+    /**
+     * Executes a task annotated with a set of resources, acquiring
+     * all resources in a global order.
+     * @param core_id Id of the core.
+     * @param channel_id Id of the channel.
+     * @param task Task to be executed.
+     * @return Task to be scheduled after execution.
+     */
+    TaskResult execute_resource_set(std::uint16_t core_id, std::uint16_t channel_id, TaskInterface *task);
+
     /**
      * Executes the read-only task optimistically.
      * @param core_id Id of the core.
      * @param channel_id Id of the channel.
      * @param resource Resource the task reads.
      * @param task Task to be executed.
+     * @param is_sampled True, when the read is sampled for the adaptive synchronization of the resource.
      * @return Task to be scheduled after execution.
      */
     TaskResult execute_optimistic_read(std::uint16_t core_id, std::uint16_t channel_id,
-                                       resource::ResourceInterface *resource, TaskInterface *task);
+                                       resource::ResourceInterface *resource, TaskInterface *task, bool is_sampled);
 };
 } // namespace mx::tasking
\ No newline at end of file
@@ -1,5 +1,12 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <mx/memory/dynamic_size_allocator.h>
+#include <string>
+#include <unistd.h>
 
 TEST(MxTasking, DynamicSizeAllocator)
 {
@@ -20,4 +27,221 @@ TEST(MxTasking, DynamicSizeAllocator)
 
     // Different allocations, different blocks
     EXPECT_NE(allocator.allocate(0U, 64U, sizeof(std::uint32_t)), allocator.allocate(0U, 64U, sizeof(std::uint32_t)));
-}
\ No newline at end of file
+}
+
+TEST(MxTasking, DynamicSizeAllocatorBulk)
+{
+    auto allocator = mx::memory::dynamic::Allocator{};
+
+    // Allocation success
+    auto objects = std::array<void *, 16U>{nullptr};
+    allocator.allocate(0U, 64U, 100U, objects.size(), objects.data());
+
+    for (auto i = 0U; i < objects.size(); ++i)
+    {
+        EXPECT_NE(objects[i], nullptr);
+
+        // Alignment
+        EXPECT_TRUE((std::uintptr_t(objects[i]) & 0x3F) == 0U);
+
+        // Contiguous and not overlapping
+        if (i > 0U)
+        {
+            EXPECT_GE(std::uintptr_t(objects[i]), std::uintptr_t(objects[i - 1U]) + 100U);
+        }
+    }
+    EXPECT_FALSE(allocator.is_free());
+
+    // Every object is freed separately; in the end, the region is merged again.
+    for (auto i = 0U; i < objects.size(); i += 2U)
+    {
+        allocator.free(objects[i]);
+    }
+    EXPECT_FALSE(allocator.is_free());
+    for (auto i = 1U; i < objects.size(); i += 2U)
+    {
+        allocator.free(objects[i]);
+    }
+    EXPECT_TRUE(allocator.is_free());
+
+    // Allocations larger than a block.
+    auto large_objects = std::array<void *, 4U>{nullptr};
+    allocator.allocate(0U, 64U, 1UL << 27U, large_objects.size(), large_objects.data());
+    for (auto *object : large_objects)
+    {
+        EXPECT_NE(object, nullptr);
+        allocator.free(object);
+    }
+}
+
+TEST(MxTasking, DynamicSizeAllocatorSizeClasses)
+{
+    auto allocator = mx::memory::dynamic::Allocator{};
+
+    // Objects of different sizes, more than cached per core
+    auto objects = std::array<void *, 256U>{nullptr};
+    for (auto i = 0U; i < objects.size(); ++i)
+    {
+        const auto size = 16U << (i % 9U);
+        objects[i] = allocator.allocate(0U, 64U, size);
+        EXPECT_NE(objects[i], nullptr);
+
+        // Alignment
+        EXPECT_TRUE((std::uintptr_t(objects[i]) & 0x3F) == 0U);
+
+        // Objects do not overlap
+        std::memset(objects[i], int(i), size);
+    }
+
+    for (auto i = 0U; i < objects.size(); ++i)
+    {
+        EXPECT_EQ(*static_cast<std::uint8_t *>(objects[i]), std::uint8_t(i));
+    }
+    EXPECT_FALSE(allocator.is_free());
+
+    for (auto *object : objects)
+    {
+        allocator.free(object);
+    }
+    EXPECT_TRUE(allocator.is_free());
+
+    // Freed objects are reused
+    auto *object = allocator.allocate(0U, 64U, 1024U);
+    allocator.free(object);
+    EXPECT_EQ(allocator.allocate(0U, 64U, 1024U), object);
+}
+
+TEST(MxTasking, DynamicSizeAllocatorTypedPool)
+{
+    struct Object
+    {
+        std::array<std::uint8_t, 192U> data;
+    };
+
+    auto allocator = mx::memory::dynamic::Allocator{};
+
+    // Objects of a type are packed without header or padding
+    auto *first = allocator.allocate<Object>(0U);
+    auto *second = allocator.allocate<Object>(0U);
+    EXPECT_TRUE((std::uintptr_t(first) & 0x3F) == 0U);
+    EXPECT_EQ(std::max(std::uintptr_t(first), std::uintptr_t(second)) -
+                  std::min(std::uintptr_t(first), std::uintptr_t(second)),
+              sizeof(Object));
+
+    // Objects of other sizes are not allocated from the pool
+    auto *other = allocator.allocate(0U, 64U, sizeof(Object));
+    EXPECT_NE(std::uintptr_t(other) / mx::memory::config::size_class_arena_size(),
+              std::uintptr_t(first) / mx::memory::config::size_class_arena_size());
+
+    // Objects larger than their type are not allocated from the pool
+    auto *larger = allocator.allocate<Object>(0U, 1024U);
+    EXPECT_NE(std::uintptr_t(larger) / mx::memory::config::size_class_arena_size(),
+              std::uintptr_t(first) / mx::memory::config::size_class_arena_size());
+    std::memset(larger, 0xFF, 1024U);
+
+    allocator.free(first);
+    allocator.free(second);
+    allocator.free(other);
+    allocator.free(larger);
+    EXPECT_TRUE(allocator.is_free());
+
+    // Freed objects are reused
+    EXPECT_EQ(allocator.allocate<Object>(0U), second);
+}
+
+TEST(MxTasking, DynamicSizeAllocatorPlacement)
+{
+    auto allocator = mx::memory::dynamic::Allocator{};
+
+    // Interleaved objects
+    auto *interleaved = allocator.allocate_interleaved(64U, 1U << 20U);
+    EXPECT_NE(interleaved, nullptr);
+    EXPECT_TRUE((std::uintptr_t(interleaved) & 0x3F) == 0U);
+    std::memset(interleaved, 1, 1U << 20U);
+    EXPECT_EQ(allocator.replicas(interleaved), nullptr);
+    EXPECT_FALSE(allocator.is_free());
+    allocator.free(interleaved);
+    EXPECT_TRUE(allocator.is_free());
+
+    // Replicated objects
+    auto *replicated = allocator.allocate_replicated(0U, 64U, 4096U);
+    EXPECT_NE(replicated, nullptr);
+    EXPECT_TRUE((std::uintptr_t(replicated) & 0x3F) == 0U);
+    const auto *replica_table = allocator.replicas(replicated);
+    EXPECT_NE(replica_table, nullptr);
+    EXPECT_EQ(replica_table->replicas[0U], replicated);
+    EXPECT_EQ(allocator.replica(replicated, 0U), replicated);
+    for (auto *replica : replica_table->replicas)
+    {
+        if (replica != nullptr)
+        {
+            EXPECT_EQ(allocator.replicas(replica)->replicas, replica_table->replicas);
+            std::memset(replica, 1, 4096U);
+        }
+    }
+    allocator.free(replicated);
+    EXPECT_TRUE(allocator.is_free());
+
+    // Other objects are not replicated
+    auto *object = allocator.allocate(0U, 64U, 1U << 20U);
+    EXPECT_EQ(allocator.replicas(object), nullptr);
+    EXPECT_EQ(allocator.replica(object, 0U), object);
+    allocator.free(object);
+}
+
+TEST(MxTasking, DynamicSizeAllocatorPersistentHeap)
+{
+    // The heap file is created empty and unique, so concurrent runs do not share it.
+    auto path = std::string{"/tmp/mxtasking_persistent_heap.XXXXXX"};
+    const auto file_descriptor = mkstemp(path.data());
+    ASSERT_GE(file_descriptor, 0);
+    close(file_descriptor);
+
+    auto *allocator = new mx::memory::dynamic::Allocator();
+
+    // A new heap is not restored
+    EXPECT_FALSE(allocator->open_persistent_heap(path, 1U << 24U));
+    EXPECT_TRUE(allocator->is_persistent());
+    EXPECT_EQ(allocator->persistent_root(), nullptr);
+
+    // Objects point to each other
+    auto *list = static_cast<std::uintptr_t *>(allocator->allocate(0U, 64U, sizeof(std::uintptr_t) * 2U));
+    auto *next = static_cast<std::uintptr_t *>(allocator->allocate(0U, 64U, 1024U));
+    EXPECT_NE(list, nullptr);
+    EXPECT_NE(next, nullptr);
+    list[0U] = 42U;
+    list[1U] = std::uintptr_t(next);
+    next[0U] = 21U;
+    allocator->persistent_root(list);
+
+    // Freed objects stay free after a restart
+    auto *freed = allocator->allocate(0U, 64U, 4096U);
+    allocator->free(freed);
+    delete allocator;
+
+    allocator = new mx::memory::dynamic::Allocator();
+    EXPECT_TRUE(allocator->open_persistent_heap(path, 1U << 24U));
+    auto *restored_list = static_cast<std::uintptr_t *>(allocator->persistent_root());
+    EXPECT_EQ(restored_list, list);
+    EXPECT_EQ(restored_list[0U], 42U);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t *>(restored_list[1U])[0U], 21U);
+
+    // New objects do not overwrite restored ones
+    auto *object = static_cast<std::uintptr_t *>(allocator->allocate(0U, 64U, 4096U));
+    EXPECT_NE(object, nullptr);
+    std::memset(object, 0, 4096U);
+    EXPECT_EQ(restored_list[0U], 42U);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t *>(restored_list[1U])[0U], 21U);
+
+    // Typed objects get the requested size, even without a pool
+    auto *neighbor = static_cast<std::uintptr_t *>(allocator->allocate(0U, 64U, 64U));
+    auto *typed_object = allocator->allocate<std::uintptr_t>(0U, 4096U);
+    EXPECT_NE(neighbor, nullptr);
+    EXPECT_NE(typed_object, nullptr);
+    neighbor[0U] = 42U;
+    std::memset(typed_object, 0, 4096U);
+    EXPECT_EQ(neighbor[0U], 42U);
+    delete allocator;
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+#include <mx/memory/dynamic_size_allocator.h>
+#include <mx/memory/reclamation/epoch_guard.h>
+#include <mx/util/maybe_atomic.h>
+
+TEST(MxTasking, EpochGuard)
+{
+    using namespace mx::memory::reclamation;
+
+    auto allocator = mx::memory::dynamic::Allocator{};
+    auto is_running = mx::util::maybe_atomic<bool>{false};
+    auto epoch_manager = std::make_unique<EpochManager>(1U, allocator, is_running);
+
+    // Workers and participants out of epochs do not hold back reclamation
+    EXPECT_EQ(epoch_manager->min_local_epoch(), std::numeric_limits<epoch_t>::max());
+
+    auto participant = EpochParticipant{*epoch_manager};
+    EXPECT_TRUE(participant.is_registered());
+    EXPECT_EQ(epoch_manager->min_local_epoch(), std::numeric_limits<epoch_t>::max());
+
+    {
+        auto guard = EpochGuard{participant};
+        EXPECT_EQ(epoch_manager->min_local_epoch(), 0U);
+
+        // Nested guards keep the epoch
+        {
+            auto nested_guard = EpochGuard{participant};
+        }
+        EXPECT_EQ(epoch_manager->min_local_epoch(), 0U);
+    }
+    EXPECT_EQ(epoch_manager->min_local_epoch(), std::numeric_limits<epoch_t>::max());
+
+    // Slots of unregistered participants are reused
+    auto *local_epoch = epoch_manager->register_external();
+    EXPECT_NE(local_epoch, nullptr);
+    epoch_manager->unregister_external(local_epoch);
+    EXPECT_EQ(epoch_manager->register_external(), local_epoch);
+}
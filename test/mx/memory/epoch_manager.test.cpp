@@ -0,0 +1,124 @@
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mx/memory/config.h>
+#include <mx/memory/dynamic_size_allocator.h>
+#include <mx/memory/reclamation/epoch_manager.h>
+#include <mx/resource/resource_interface.h>
+#include <mx/util/maybe_atomic.h>
+
+namespace {
+class CountedResource final : public mx::resource::ResourceInterface
+{
+public:
+    explicit CountedResource(std::uint32_t &count_destroyed) noexcept : _count_destroyed(count_destroyed) {}
+    ~CountedResource() noexcept override { ++_count_destroyed; }
+
+    void on_reclaim() override { this->~CountedResource(); }
+
+private:
+    std::uint32_t &_count_destroyed;
+};
+} // namespace
+
+TEST(MxTasking, EpochManagerReplicatedGarbage)
+{
+    using namespace mx::memory::reclamation;
+
+    auto allocator = mx::memory::dynamic::Allocator{};
+    auto is_running = mx::util::maybe_atomic<bool>{false};
+    auto epoch_manager = std::make_unique<EpochManager>(1U, allocator, is_running);
+
+    auto count_destroyed = std::uint32_t{0U};
+    auto count_replicas = std::uint32_t{0U};
+    auto *object = allocator.allocate_replicated(0U, 64U, sizeof(CountedResource));
+    ASSERT_NE(object, nullptr);
+    for (auto *replica : allocator.replicas(object)->replicas)
+    {
+        if (replica != nullptr)
+        {
+            new (replica) CountedResource(count_destroyed);
+            ++count_replicas;
+        }
+    }
+
+    // Reclaiming a replicated resource destroys every replica.
+    epoch_manager->add_to_garbage_collection(static_cast<CountedResource *>(object), 0U);
+    epoch_manager->reclaim(0U, 0U, 1U);
+    EXPECT_EQ(count_destroyed, count_replicas);
+    EXPECT_TRUE(allocator.is_free());
+}
+
+TEST(MxTasking, EpochManagerBucketAging)
+{
+    using namespace mx::memory::reclamation;
+    constexpr auto limbo_buckets = mx::memory::config::limbo_buckets();
+
+    auto allocator = mx::memory::dynamic::Allocator{};
+    auto is_running = mx::util::maybe_atomic<bool>{false};
+    auto epoch_manager = std::make_unique<EpochManager>(1U, allocator, is_running);
+
+    // The global epoch does not move past the buckets of the oldest epoch in use
+    auto *local_epoch = epoch_manager->register_external();
+    ASSERT_NE(local_epoch, nullptr);
+    local_epoch->enter(epoch_manager->global_epoch());
+    for (auto i = 0U; i < limbo_buckets * 2U; ++i)
+    {
+        epoch_manager->enter_next_epoch();
+    }
+    EXPECT_EQ(epoch_manager->global_epoch().load(), limbo_buckets - 1U);
+    epoch_manager->unregister_external(local_epoch);
+
+    // Resources removed in epochs sharing a bucket, because the global epoch wrapped around
+    auto count_destroyed = std::uint32_t{0U};
+    auto *old_resource = new (allocator.allocate(0U, 64U, sizeof(CountedResource))) CountedResource(count_destroyed);
+    auto *new_resource = new (allocator.allocate(0U, 64U, sizeof(CountedResource))) CountedResource(count_destroyed);
+    const auto old_epoch = epoch_manager->global_epoch().load();
+    epoch_manager->add_to_garbage_collection(old_resource, 0U);
+    for (auto i = 0U; i < limbo_buckets; ++i)
+    {
+        EXPECT_TRUE(epoch_manager->enter_next_epoch());
+    }
+    epoch_manager->add_to_garbage_collection(new_resource, 0U);
+    EXPECT_EQ(new_resource->remove_epoch(), old_epoch + limbo_buckets);
+
+    // Releasing the old epoch keeps the resource of the new epoch...
+    epoch_manager->reclaim(0U, old_epoch, old_epoch + 1U);
+    EXPECT_EQ(count_destroyed, 1U);
+    EXPECT_FALSE(allocator.is_free());
+
+    // ... until its epoch is released, too.
+    epoch_manager->reclaim(0U, old_epoch + 1U, old_epoch + limbo_buckets + 1U);
+    EXPECT_EQ(count_destroyed, 2U);
+    EXPECT_TRUE(allocator.is_free());
+}
+
+TEST(MxTasking, EpochManagerAdaptiveInterval)
+{
+    using namespace mx::memory::reclamation;
+    const auto max_interval =
+        std::chrono::duration_cast<std::chrono::microseconds>(mx::memory::config::epoch_interval());
+    const auto min_interval =
+        std::chrono::duration_cast<std::chrono::microseconds>(mx::memory::config::min_epoch_interval());
+    const auto much_garbage = std::uint64_t{mx::memory::config::epoch_garbage_threshold()} + 1U;
+
+    // Much garbage halves the interval down to the minimum
+    auto interval = max_interval;
+    interval = EpochManager::adapt_epoch_interval(interval, much_garbage);
+    EXPECT_EQ(interval, max_interval / 2U);
+    for (auto i = 0U; i < 64U; ++i)
+    {
+        interval = EpochManager::adapt_epoch_interval(interval, much_garbage);
+    }
+    EXPECT_EQ(interval, min_interval);
+
+    // Little garbage doubles the interval up to the maximum
+    interval = EpochManager::adapt_epoch_interval(interval, 0U);
+    EXPECT_EQ(interval, min_interval * 2U);
+    for (auto i = 0U; i < 64U; ++i)
+    {
+        interval = EpochManager::adapt_epoch_interval(interval, mx::memory::config::epoch_garbage_threshold());
+    }
+    EXPECT_EQ(interval, max_interval);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <mx/memory/fixed_size_allocator.h>
+#include <set>
+#include <vector>
 
 TEST(MxTasking, FixedSizeAllocator)
 {
@@ -47,9 +49,148 @@ TEST(MxTasking, FixedSizeAllocator)
         // Different blocks of different cores
         EXPECT_NE(allocator.allocate(0U), allocator.allocate(1U));
 
-        // Move block to different core
+        // Blocks freed by a different core are returned to their home core
         auto *m2 = allocator.allocate(0U);
         allocator.free(1U, m2);
-        EXPECT_EQ(allocator.allocate(1U), m2);
+        EXPECT_NE(allocator.allocate(1U), m2);
     }
-}
\ No newline at end of file
+
+    // Remote free
+    {
+        auto core_set = mx::util::core_set{};
+        core_set.emplace_back(0U);
+        core_set.emplace_back(1U);
+
+        auto allocator = mx::memory::fixed::Allocator<64U>{core_set};
+
+        // Exhaust the blocks of core 0 and free a batch of them on core 1.
+        auto blocks = std::vector<void *>{};
+        auto *block = allocator.allocate(0U);
+        const auto *chunk = mx::memory::fixed::Chunk::header(block);
+        while (mx::memory::fixed::Chunk::header(block) == chunk)
+        {
+            blocks.push_back(block);
+            block = allocator.allocate(0U);
+        }
+        EXPECT_EQ(blocks.size(), mx::memory::fixed::Chunk::size() / 64U - 1U);
+
+        for (auto i = 0U; i < mx::memory::config::remote_free_batch_size(); ++i)
+        {
+            allocator.free(1U, blocks[i]);
+        }
+
+        // Core 0 uses the returned blocks, when its own blocks are exhausted.
+        while (mx::memory::fixed::Chunk::header(block) != chunk)
+        {
+            block = allocator.allocate(0U);
+        }
+        EXPECT_EQ(mx::memory::fixed::Chunk::header(block)->core_id(), 0U);
+    }
+
+    // Chunks are taken by the first allocation, not by creating the allocator
+    {
+        auto core_set = mx::util::core_set{};
+        core_set.emplace_back(0U);
+
+        auto allocator = mx::memory::fixed::Allocator<64U>{core_set};
+        const auto numa_node_id = mx::system::topology::node_id(0U);
+        EXPECT_EQ(allocator.statistic(numa_node_id).count_chunks, 0U);
+
+        allocator.free(0U, allocator.allocate(0U));
+        EXPECT_EQ(allocator.statistic(numa_node_id).count_chunks, 1U);
+    }
+
+    // Heaps for further NUMA regions take chunks on their first allocation only
+    {
+        auto core_set = mx::util::core_set{};
+        core_set.emplace_back(0U);
+        core_set.emplace_back(1U);
+
+        auto allocator = mx::memory::fixed::Allocator<64U>{core_set};
+        const auto numa_node_id = mx::system::topology::node_id(0U);
+
+        allocator.free(0U, allocator.allocate(0U, numa_node_id));
+        EXPECT_EQ(allocator.statistic(numa_node_id).count_chunks, 1U);
+        for (auto node_id = std::uint8_t(0U); node_id < mx::memory::config::max_numa_nodes(); ++node_id)
+        {
+            if (node_id != numa_node_id)
+            {
+                EXPECT_EQ(allocator.statistic(node_id).count_chunks, 0U);
+            }
+        }
+    }
+
+    // Partial batches are returned when flushed
+    {
+        auto core_set = mx::util::core_set{};
+        core_set.emplace_back(0U);
+        core_set.emplace_back(1U);
+
+        auto allocator = mx::memory::fixed::Allocator<64U>{core_set};
+
+        // Exhaust the first chunk of core 0 and free a single block on core 1.
+        auto blocks = std::vector<void *>{};
+        for (auto i = 0U; i < mx::memory::fixed::Chunk::size() / 64U - 1U; ++i)
+        {
+            blocks.push_back(allocator.allocate(0U));
+        }
+        allocator.free(1U, blocks.front());
+        allocator.flush(1U);
+
+        // Core 0 uses the returned block instead of a new chunk.
+        EXPECT_EQ(allocator.allocate(0U), blocks.front());
+    }
+
+    // Unused chunks are given back and reused after trimming
+    {
+        auto core_set = mx::util::core_set{};
+        core_set.emplace_back(0U);
+
+        auto allocator = mx::memory::fixed::Allocator<64U>{core_set};
+
+        constexpr auto count_chunks = mx::memory::config::max_cached_free_chunks() + 3U;
+        constexpr auto count_objects_per_chunk = mx::memory::fixed::Chunk::size() / 64U - 1U;
+
+        auto blocks = std::vector<void *>{};
+        auto chunks = std::set<const mx::memory::fixed::ChunkHeader *>{};
+        for (auto i = 0U; i < count_chunks * count_objects_per_chunk; ++i)
+        {
+            blocks.push_back(allocator.allocate(0U));
+            chunks.insert(mx::memory::fixed::Chunk::header(blocks.back()));
+        }
+        EXPECT_EQ(chunks.size(), count_chunks);
+
+        for (auto *block : blocks)
+        {
+            allocator.free(0U, block);
+        }
+        allocator.trim();
+
+        // Every chunk is used again.
+        blocks.clear();
+        for (auto i = 0U; i < count_chunks * count_objects_per_chunk; ++i)
+        {
+            blocks.push_back(allocator.allocate(0U));
+            EXPECT_EQ(chunks.count(mx::memory::fixed::Chunk::header(blocks.back())), 1U);
+        }
+    }
+
+    // Objects allocated for a NUMA region
+    {
+        auto core_set = mx::util::core_set{};
+        core_set.emplace_back(0U);
+
+        auto allocator = mx::memory::fixed::Allocator<64U>{core_set};
+        const auto numa_node_id = mx::system::topology::node_id(0U);
+
+        auto *block = allocator.allocate(0U, numa_node_id);
+        EXPECT_EQ(mx::memory::fixed::Chunk::header(block)->numa_node_id(), numa_node_id);
+        EXPECT_EQ(mx::memory::fixed::Chunk::header(block)->core_id(), 0U);
+        allocator.free(0U, block);
+
+        // Regions without cores are replaced by the region of the core.
+        block = allocator.allocate(0U, std::uint8_t(mx::memory::config::max_numa_nodes()));
+        EXPECT_EQ(mx::memory::fixed::Chunk::header(block)->numa_node_id(), numa_node_id);
+        allocator.free(0U, block);
+    }
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <mx/memory/statistic.h>
+#include <thread>
+#include <vector>
+
+TEST(MxTasking, AllocatorStatistic)
+{
+    using mx::memory::Statistic;
+
+    auto statistic = std::make_unique<Statistic>();
+
+    // Threads not bound to a channel count in the external slot
+    statistic->add<Statistic::AllocatedObjects>();
+    statistic->add<Statistic::AllocatedBytes>(64U);
+    EXPECT_EQ(statistic->get(Statistic::AllocatedObjects, Statistic::EXTERNAL_SLOT), 1U);
+    EXPECT_EQ(statistic->get(Statistic::AllocatedBytes, Statistic::EXTERNAL_SLOT), 64U);
+
+    // Bound threads count in the slot of their channel
+    std::thread{[&statistic] {
+        Statistic::bind(3U);
+        statistic->add<Statistic::FreedObjects>(2U);
+        Statistic::unbind();
+        statistic->add<Statistic::FreedObjects>();
+    }}.join();
+    EXPECT_EQ(statistic->get(Statistic::FreedObjects, 3U), 2U);
+    EXPECT_EQ(statistic->get(Statistic::FreedObjects, Statistic::EXTERNAL_SLOT), 1U);
+    EXPECT_EQ(statistic->get(Statistic::FreedObjects), 3U);
+
+    // The slot of external threads is shared without losing counts
+    constexpr auto count_threads = 4U;
+    constexpr auto count_increments = 100000U;
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0U; i < count_threads; ++i)
+    {
+        threads.emplace_back([&statistic] {
+            for (auto j = 0U; j < count_increments; ++j)
+            {
+                statistic->add<Statistic::RemoteFrees>();
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(statistic->get(Statistic::RemoteFrees), count_threads * count_increments);
+}
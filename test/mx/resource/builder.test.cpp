@@ -0,0 +1,198 @@
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mx/memory/dynamic_size_allocator.h>
+#include <mx/resource/builder.h>
+#include <mx/tasking/runtime.h>
+#include <mx/tasking/scheduler.h>
+#include <mx/util/core_set.h>
+#include <string>
+#include <unistd.h>
+
+namespace {
+class Counter final : public mx::resource::ResourceInterface
+{
+public:
+    explicit Counter(const std::uint64_t value_) noexcept : value(value_) {}
+    ~Counter() override = default;
+
+    void on_reclaim() override {}
+
+    std::uint64_t value;
+};
+
+class Record final : public mx::resource::ResourceInterface
+{
+public:
+    explicit Record(const std::uint64_t value) noexcept : _value(value) {}
+    explicit Record(const mx::resource::restore_t restore) noexcept : ResourceInterface(restore) {}
+    ~Record() override = default;
+
+    void on_reclaim() override { _value = 0U; }
+
+    [[nodiscard]] std::uint64_t value() const noexcept { return _value; }
+
+private:
+    // Kept by the restore constructor, thus, without default initializer.
+    std::uint64_t _value;
+};
+} // namespace
+
+TEST(MxTasking, BuilderBulk)
+{
+    auto allocator = mx::memory::dynamic::Allocator{};
+
+    // Channels are not started, so both may share a core.
+    const auto core_set = mx::util::core_set{0U, 0U};
+    auto scheduler = std::make_unique<mx::tasking::Scheduler>(core_set, 0U, allocator);
+    auto builder = mx::resource::Builder{*scheduler, allocator};
+
+    // Resources are spread over the channels like single resources.
+    constexpr auto count = 16U;
+    const auto resources =
+        builder.build<Counter>(count, sizeof(Counter), mx::resource::hint{mx::synchronization::isolation_level::None},
+                               std::uint64_t{42U});
+    ASSERT_EQ(resources.size(), count);
+
+    auto count_resources = std::array<std::uint32_t, 2U>{0U};
+    for (const auto resource : resources)
+    {
+        ASSERT_NE(resource.get(), nullptr);
+        ASSERT_LT(resource.channel_id(), core_set.size());
+        EXPECT_EQ(resource.get<Counter>()->value, 42U);
+        ++count_resources[resource.channel_id()];
+    }
+    EXPECT_EQ(count_resources[0U], count / 2U);
+    EXPECT_EQ(count_resources[1U], count / 2U);
+
+    // The resources of a NUMA region are carved in order from one allocation.
+    auto last_resource = std::array<std::uintptr_t, mx::memory::config::max_numa_nodes()>{0U};
+    auto stride = std::array<std::uintptr_t, mx::memory::config::max_numa_nodes()>{0U};
+    for (auto i = 0U; i < count; ++i)
+    {
+        const auto numa_node_id = scheduler->numa_node_id(resources[i].channel_id());
+        const auto address = std::uintptr_t(resources[i].get());
+        if (last_resource[numa_node_id] != 0U)
+        {
+            ASSERT_GT(address, last_resource[numa_node_id]);
+            if (stride[numa_node_id] == 0U)
+            {
+                stride[numa_node_id] = address - last_resource[numa_node_id];
+            }
+            EXPECT_EQ(address - last_resource[numa_node_id], stride[numa_node_id]);
+        }
+        last_resource[numa_node_id] = address;
+    }
+
+    for (const auto resource : resources)
+    {
+        builder.destroy<Counter>(resource);
+    }
+
+    // Resources hinted with a channel are placed there.
+    const auto hinted_resources = builder.build<Counter>(
+        4U, sizeof(Counter), mx::resource::hint{std::uint16_t(1U), mx::synchronization::isolation_level::None},
+        std::uint64_t{21U});
+    for (const auto resource : hinted_resources)
+    {
+        ASSERT_NE(resource.get(), nullptr);
+        EXPECT_EQ(resource.channel_id(), 1U);
+        builder.destroy<Counter>(resource);
+    }
+    EXPECT_TRUE(allocator.is_free());
+}
+
+TEST(MxTasking, BuilderBulkReplicated)
+{
+    auto allocator = mx::memory::dynamic::Allocator{};
+    const auto core_set = mx::util::core_set{0U};
+    auto scheduler = std::make_unique<mx::tasking::Scheduler>(core_set, 0U, allocator);
+    auto builder = mx::resource::Builder{*scheduler, allocator};
+
+    // Every replica of every resource is built.
+    constexpr auto placement = mx::resource::hint::memory_placement::replicated;
+    const auto resources = builder.build<Counter>(
+        4U, sizeof(Counter), mx::resource::hint{mx::synchronization::isolation_level::None, placement},
+        std::uint64_t{42U});
+    ASSERT_EQ(resources.size(), 4U);
+    for (const auto resource : resources)
+    {
+        ASSERT_NE(resource.get(), nullptr);
+        const auto *replica_table = allocator.replicas(resource.get());
+        ASSERT_NE(replica_table, nullptr);
+        for (auto *replica : replica_table->replicas)
+        {
+            if (replica != nullptr)
+            {
+                EXPECT_EQ(static_cast<Counter *>(replica)->value, 42U);
+            }
+        }
+        builder.destroy<Counter>(resource);
+    }
+    EXPECT_TRUE(allocator.is_free());
+}
+
+TEST(MxTasking, BuilderBulkExhaustedHeap)
+{
+    auto path = std::string{"/tmp/mxtasking_builder_heap.XXXXXX"};
+    const auto file_descriptor = mkstemp(path.data());
+    ASSERT_GE(file_descriptor, 0);
+    close(file_descriptor);
+
+    auto allocator = mx::memory::dynamic::Allocator{};
+    const auto core_set = mx::util::core_set{0U};
+    auto scheduler = std::make_unique<mx::tasking::Scheduler>(core_set, 0U, allocator);
+    auto builder = mx::resource::Builder{*scheduler, allocator};
+    allocator.open_persistent_heap(path, 1U << 20U);
+
+    // Resources, which do not fit into the heap, are not built.
+    const auto resources = builder.build<Counter>(
+        64U, 1U << 16U, mx::resource::hint{mx::synchronization::isolation_level::None}, std::uint64_t{42U});
+    ASSERT_EQ(resources.size(), 64U);
+    for (const auto resource : resources)
+    {
+        EXPECT_EQ(resource.get(), nullptr);
+        EXPECT_EQ(resource.channel_id(), 0U);
+    }
+
+    allocator.close_persistent_heap();
+    std::remove(path.c_str());
+}
+
+TEST(MxTasking, BuilderRestore)
+{
+    using namespace mx::tasking;
+
+    auto path = std::string{"/tmp/mxtasking_restore_heap.XXXXXX"};
+    const auto file_descriptor = mkstemp(path.data());
+    ASSERT_GE(file_descriptor, 0);
+    close(file_descriptor);
+
+    ASSERT_TRUE(runtime::init(mx::util::core_set{0U}, 0U, false));
+    EXPECT_FALSE(runtime::open_persistent_heap(path, 1U << 24U));
+    const auto resource = runtime::new_resource<Record>(
+        sizeof(Record), mx::resource::hint{mx::synchronization::isolation_level::ExclusiveWriter}, std::uint64_t{42U});
+    ASSERT_NE(resource.get(), nullptr);
+
+    // The resource was written by a previous run, whose virtual tables were elsewhere.
+    // The pointer to the virtual table is stored first (Itanium C++ ABI).
+    std::memset(resource.get(), 0xFF, sizeof(void *));
+    runtime::persistent_root(resource.get());
+    runtime::close_persistent_heap();
+
+    // Restored resources keep their members and can be used through their virtual functions.
+    EXPECT_TRUE(runtime::open_persistent_heap(path, 1U << 24U));
+    auto *record = static_cast<Record *>(runtime::persistent_root());
+    const auto restored_resource = runtime::restore_resource<Record>(
+        record, mx::resource::hint{mx::synchronization::isolation_level::ExclusiveWriter});
+    EXPECT_EQ(restored_resource.get(), resource.get());
+    EXPECT_EQ(restored_resource.get<Record>()->value(), 42U);
+    restored_resource.get<mx::resource::ResourceInterface>()->on_reclaim();
+    EXPECT_EQ(restored_resource.get<Record>()->value(), 0U);
+
+    runtime::close_persistent_heap();
+    std::remove(path.c_str());
+}
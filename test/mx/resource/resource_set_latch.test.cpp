@@ -0,0 +1,120 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <mx/resource/resource_set_latch.h>
+#include <thread>
+#include <vector>
+
+namespace {
+class Counter final : public mx::resource::ResourceInterface
+{
+public:
+    Counter() noexcept = default;
+    ~Counter() override = default;
+
+    void on_reclaim() override {}
+
+    std::uint64_t value{0U};
+};
+} // namespace
+
+TEST(MxTasking, ResourceSetLatch)
+{
+    auto counters = std::array<Counter, 3U>{};
+    const auto resources = std::array<mx::resource::ptr, 3U>{
+        mx::resource::ptr{&counters[0U], mx::resource::information{0U, mx::synchronization::primitive::ExclusiveLatch}},
+        mx::resource::ptr{&counters[1U], mx::resource::information{0U, mx::synchronization::primitive::MCSLatch}},
+        mx::resource::ptr{&counters[2U],
+                          mx::resource::information{0U, mx::synchronization::primitive::ReaderWriterLatch}}};
+    for (auto i = 0U; i < counters.size(); ++i)
+    {
+        counters[i].initialize_synchronization(resources[i].synchronization_primitive());
+    }
+
+    // Threads acquire the resources annotated in different orders.
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0U; i < 4U; ++i)
+    {
+        threads.emplace_back([&resources, &counters, channel_id = std::uint16_t(i)] {
+            auto annotated = resources;
+            if (channel_id % 2U == 1U)
+            {
+                std::reverse(annotated.begin(), annotated.end());
+            }
+
+            for (auto j = 0U; j < 10000U; ++j)
+            {
+                auto latch = mx::resource::ResourceSetLatch{annotated.data(), annotated.size(), false, channel_id, 0U};
+                latch.lock();
+                for (auto &counter : counters)
+                {
+                    ++counter.value;
+                }
+                EXPECT_EQ(latch.is_valid(), true);
+                latch.unlock();
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (auto &counter : counters)
+    {
+        EXPECT_EQ(counter.value, 40000U);
+    }
+
+    // Optimistic readers detect modifications.
+    auto optimistic_counter = Counter{};
+    const auto optimistic_resource =
+        mx::resource::ptr{&optimistic_counter, mx::resource::information{0U, mx::synchronization::primitive::OLFIT}};
+    auto reader = mx::resource::ResourceSetLatch{&optimistic_resource, 1U, true, 0U, 0U};
+    reader.lock();
+    EXPECT_EQ(reader.is_valid(), true);
+    {
+        mx::resource::ResourceInterface::scoped_olfit_latch _{&optimistic_counter};
+        ++optimistic_counter.value;
+    }
+    EXPECT_EQ(reader.is_valid(), false);
+    reader.unlock();
+}
+
+TEST(MxTasking, ResourceSetLatchReaders)
+{
+    auto counters = std::array<Counter, 2U>{};
+    const auto resources = std::array<mx::resource::ptr, 2U>{
+        mx::resource::ptr{&counters[0U],
+                          mx::resource::information{0U, mx::synchronization::primitive::ReaderWriterLatch}},
+        mx::resource::ptr{&counters[1U],
+                          mx::resource::information{0U, mx::synchronization::primitive::ReaderWriterLatch}}};
+    for (auto &counter : counters)
+    {
+        counter.initialize_synchronization(mx::synchronization::primitive::ReaderWriterLatch);
+    }
+
+    // Writers have to wait for a reader holding several latches of the same channel.
+    auto reader = mx::resource::ResourceSetLatch{resources.data(), resources.size(), true, 0U, 0U};
+    reader.lock();
+
+    auto is_written = std::atomic_bool{false};
+    auto writer = std::thread{[&resources, &is_written] {
+        for (const auto &resource : resources)
+        {
+            auto latch = mx::resource::ResourceSetLatch{&resource, 1U, false, 1U, 0U};
+            latch.lock();
+            is_written = true;
+            latch.unlock();
+        }
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50U));
+    EXPECT_EQ(is_written.load(), false);
+    reader.unlock();
+
+    writer.join();
+    EXPECT_EQ(is_written.load(), true);
+}
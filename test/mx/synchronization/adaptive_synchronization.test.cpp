@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include <mx/synchronization/adaptive_synchronization.h>
+#include <mx/tasking/config.h>
+
+TEST(MxTasking, AdaptiveSynchronization)
+{
+    auto synchronization = mx::synchronization::AdaptiveSynchronization{};
+    synchronization.reset(mx::synchronization::primitive::ReaderWriterLatch);
+    EXPECT_EQ(synchronization.current(), mx::synchronization::primitive::OLFIT);
+
+    // Reads and writes are counted within the window.
+    EXPECT_EQ(synchronization.sample_read(0U), false);
+    EXPECT_EQ(synchronization.sample_write(0U), false);
+    EXPECT_EQ(synchronization.sampled_reads(), 1U);
+    EXPECT_EQ(synchronization.sampled_writes(), 1U);
+
+    // Rare conflicts keep writers executing anywhere.
+    for (auto i = 3U; i < mx::tasking::config::adaptive_synchronization_window(); ++i)
+    {
+        EXPECT_EQ(synchronization.sample_read(0U), false);
+    }
+    EXPECT_EQ(synchronization.sample_write(0U), false);
+    EXPECT_EQ(synchronization.current(), mx::synchronization::primitive::OLFIT);
+    EXPECT_EQ(synchronization.sampled_reads(), 0U);
+    EXPECT_EQ(synchronization.sampled_writes(), 0U);
+
+    // Aborting readers without sampled writers do not schedule writers.
+    for (auto i = 1U; i < mx::tasking::config::adaptive_synchronization_window(); ++i)
+    {
+        EXPECT_EQ(synchronization.sample_read(1U), false);
+    }
+    EXPECT_EQ(synchronization.sample_read(1U), false);
+    EXPECT_EQ(synchronization.current(), mx::synchronization::primitive::OLFIT);
+
+    // Spiking conflicts (aborted readers and spinning writers) schedule writers to the channel of the resource.
+    for (auto i = 1U; i < mx::tasking::config::adaptive_synchronization_window(); ++i)
+    {
+        EXPECT_EQ(i % 2U == 0U ? synchronization.sample_read(1U) : synchronization.sample_write(2U), false);
+    }
+    EXPECT_EQ(synchronization.sample_read(0U), true);
+    EXPECT_EQ(synchronization.current(), mx::synchronization::primitive::ScheduleWriter);
+
+    // Once conflicts are rare again, writers execute anywhere.
+    for (auto i = 1U; i < mx::tasking::config::adaptive_synchronization_window(); ++i)
+    {
+        EXPECT_EQ(synchronization.sample_write(0U), false);
+    }
+    EXPECT_EQ(synchronization.sample_read(0U), true);
+    EXPECT_EQ(synchronization.current(), mx::synchronization::primitive::OLFIT);
+}
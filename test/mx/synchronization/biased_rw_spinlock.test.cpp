@@ -0,0 +1,53 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <mx/synchronization/biased_rw_spinlock.h>
+#include <thread>
+#include <vector>
+
+TEST(MxTasking, BiasedRWSpinLock)
+{
+    auto lock = mx::synchronization::BiasedRWSpinLock{};
+    EXPECT_EQ(lock.is_reader_biased(), true);
+
+    // Readers are published in the visible readers table.
+    const auto is_visible_reader = lock.lock_shared(0U);
+    EXPECT_EQ(is_visible_reader, true);
+    lock.unlock_shared(0U, is_visible_reader);
+
+    // Writers revoke the bias; following readers use the latch.
+    lock.lock();
+    EXPECT_EQ(lock.is_reader_biased(), false);
+    lock.unlock();
+    const auto is_latched_reader = lock.lock_shared(0U) == false;
+    EXPECT_EQ(is_latched_reader, true);
+    lock.unlock_shared(0U, false);
+
+    auto counter = std::uint64_t{0U};
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0U; i < 4U; ++i)
+    {
+        threads.emplace_back([&lock, &counter, channel_id = std::uint16_t(i)] {
+            for (auto j = 0U; j < 10000U; ++j)
+            {
+                if (j % 8U == 0U)
+                {
+                    lock.lock();
+                    ++counter;
+                    lock.unlock();
+                }
+                else
+                {
+                    const auto is_visible = lock.lock_shared(channel_id);
+                    EXPECT_LE(counter, 5000U);
+                    lock.unlock_shared(channel_id, is_visible);
+                }
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(counter, 5000U);
+}
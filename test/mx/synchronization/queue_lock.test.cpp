@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <mx/synchronization/cohort_lock.h>
+#include <mx/synchronization/mcs_lock.h>
+#include <thread>
+#include <vector>
+
+TEST(MxTasking, MCSLock)
+{
+    auto lock = mx::synchronization::MCSLock{};
+    EXPECT_EQ(lock.is_locked(), false);
+
+    auto queue_node = mx::synchronization::MCSLock::QueueNode{};
+    lock.lock(queue_node);
+    EXPECT_EQ(lock.is_locked(), true);
+
+    auto other_queue_node = mx::synchronization::MCSLock::QueueNode{};
+    EXPECT_EQ(lock.try_lock(other_queue_node), false);
+
+    lock.unlock(queue_node);
+    EXPECT_EQ(lock.is_locked(), false);
+    EXPECT_EQ(lock.try_lock(other_queue_node), true);
+    lock.unlock(other_queue_node);
+    EXPECT_EQ(lock.is_locked(), false);
+
+    auto counter = std::uint64_t{0U};
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0U; i < 4U; ++i)
+    {
+        threads.emplace_back([&lock, &counter] {
+            for (auto j = 0U; j < 10000U; ++j)
+            {
+                auto node = mx::synchronization::MCSLock::QueueNode{};
+                lock.lock(node);
+                ++counter;
+                lock.unlock(node);
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(counter, 40000U);
+    EXPECT_EQ(lock.is_locked(), false);
+}
+
+TEST(MxTasking, CohortLock)
+{
+    auto lock = mx::synchronization::CohortLock{};
+    EXPECT_EQ(lock.is_locked(), false);
+
+    auto queue_node = mx::synchronization::CohortLock::QueueNode{};
+    lock.lock(queue_node, 0U);
+    EXPECT_EQ(lock.is_locked(), true);
+    lock.unlock(queue_node, 0U);
+    EXPECT_EQ(lock.is_locked(), false);
+
+    // Threads of different (simulated) NUMA regions.
+    auto counter = std::uint64_t{0U};
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0U; i < 4U; ++i)
+    {
+        const auto numa_node_id = std::uint8_t(i % mx::memory::config::max_numa_nodes());
+        threads.emplace_back([&lock, &counter, numa_node_id] {
+            for (auto j = 0U; j < 10000U; ++j)
+            {
+                auto node = mx::synchronization::CohortLock::QueueNode{};
+                lock.lock(node, numa_node_id);
+                ++counter;
+                lock.unlock(node, numa_node_id);
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(counter, 40000U);
+    EXPECT_EQ(lock.is_locked(), false);
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <mx/resource/resource.h>
+#include <mx/tasking/channel_occupancy.h>
+
+TEST(MxTasking, ChannelOccupancyLoad)
+{
+    auto occupancy = mx::tasking::ChannelOccupancy{};
+    EXPECT_EQ(occupancy.load(), 0U);
+
+    occupancy.predict(mx::resource::hint::expected_access_frequency::unused);
+    EXPECT_EQ(occupancy.load(), 0U);
+
+    // A single high used resource outweighs some normal used resources.
+    auto normal_occupancy = mx::tasking::ChannelOccupancy{};
+    for (auto i = 0U; i < 4U; ++i)
+    {
+        normal_occupancy.predict(mx::resource::hint::expected_access_frequency::normal);
+    }
+    occupancy.predict(mx::resource::hint::expected_access_frequency::high);
+    EXPECT_GT(occupancy.load(), normal_occupancy.load());
+
+    // An excessive used resource outweighs some high used resources.
+    auto excessive_occupancy = mx::tasking::ChannelOccupancy{};
+    excessive_occupancy.predict(mx::resource::hint::expected_access_frequency::excessive);
+    for (auto i = 0U; i < 4U; ++i)
+    {
+        occupancy.predict(mx::resource::hint::expected_access_frequency::high);
+    }
+    EXPECT_GT(excessive_occupancy.load(), occupancy.load());
+
+    // Revoked predictions do not count any more.
+    excessive_occupancy.revoke(mx::resource::hint::expected_access_frequency::excessive);
+    EXPECT_EQ(excessive_occupancy.load(), 0U);
+}
+
+TEST(MxTasking, ChannelOccupancyMeasuredLoad)
+{
+    auto occupancy = mx::tasking::ChannelOccupancy{};
+    for (auto i = 0U; i < 128U; ++i)
+    {
+        occupancy.measure(32U);
+    }
+    EXPECT_GE(occupancy.load(), 30U);
+    EXPECT_LE(occupancy.load(), 32U);
+
+    for (auto i = 0U; i < 128U; ++i)
+    {
+        occupancy.measure(0U);
+    }
+    EXPECT_LE(occupancy.load(), 1U);
+}
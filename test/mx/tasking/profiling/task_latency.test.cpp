@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <mx/tasking/profiling/task_latency.h>
+
+TEST(MxTasking, LatencyHistogramPercentile)
+{
+    auto histogram = mx::tasking::profiling::LatencyHistogram{};
+    EXPECT_EQ(histogram.count(), 0U);
+    EXPECT_EQ(histogram.percentile(0.5), 0U);
+
+    // Small latencies are recorded exactly.
+    histogram.add(3U);
+    EXPECT_EQ(histogram.count(), 1U);
+    EXPECT_EQ(histogram.percentile(0.5), 3U);
+
+    // 98 fast, one slow, and one very slow latency.
+    for (auto i = 0U; i < 97U; ++i)
+    {
+        histogram.add(100U);
+    }
+    histogram.add(10000U);
+    histogram.add(1000000U);
+    EXPECT_EQ(histogram.count(), 100U);
+
+    // Percentiles are the upper bound of their bucket, at most 25% above the latency.
+    EXPECT_GE(histogram.percentile(0.5), 100U);
+    EXPECT_LE(histogram.percentile(0.5), 125U);
+    EXPECT_GE(histogram.percentile(0.99), 10000U);
+    EXPECT_LE(histogram.percentile(0.99), 12500U);
+    EXPECT_GE(histogram.percentile(0.999), 1000000U);
+    EXPECT_LE(histogram.percentile(0.999), 1250000U);
+    EXPECT_GE(histogram.percentile(1.0), 1000000U);
+}
+
+TEST(MxTasking, LatencyHistogramMerge)
+{
+    auto fast = mx::tasking::profiling::LatencyHistogram{};
+    auto slow = mx::tasking::profiling::LatencyHistogram{};
+    for (auto i = 0U; i < 50U; ++i)
+    {
+        fast.add(64U);
+        slow.add(std::uint64_t{1U} << 40U);
+    }
+
+    fast.merge(slow);
+    EXPECT_EQ(fast.count(), 100U);
+    EXPECT_EQ(fast.percentile(0.5), 79U);
+    EXPECT_GE(fast.percentile(0.99), std::uint64_t{1U} << 40U);
+}
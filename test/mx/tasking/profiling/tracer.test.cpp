@@ -0,0 +1,50 @@
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mx/tasking/config.h>
+#include <mx/tasking/profiling/tracer.h>
+#include <vector>
+
+TEST(MxTasking, ChannelTraceRing)
+{
+    auto trace = std::make_unique<mx::tasking::profiling::ChannelTrace>();
+
+    auto count_events = 0U;
+    trace->for_each([&count_events](const auto &) { ++count_events; });
+    EXPECT_EQ(count_events, 0U);
+
+    // Only the latest events are held, from oldest to latest.
+    const auto &task_type = typeid(int);
+    constexpr auto count_recorded = mx::tasking::config::trace_buffer_size() + 10U;
+    for (auto i = 0U; i < count_recorded; ++i)
+    {
+        trace->record_task(task_type, nullptr, 1U, i, i, i + 1U);
+    }
+
+    auto start_timestamps = std::vector<std::uint64_t>{};
+    trace->for_each([&start_timestamps](const auto &event) { start_timestamps.push_back(event.start_timestamp); });
+    ASSERT_EQ(start_timestamps.size(), mx::tasking::config::trace_buffer_size());
+    EXPECT_EQ(start_timestamps.front(), 10U);
+    EXPECT_EQ(start_timestamps.back(), count_recorded - 1U);
+}
+
+TEST(MxTasking, ChannelTraceIdleFills)
+{
+    auto trace = std::make_unique<mx::tasking::profiling::ChannelTrace>();
+
+    // Consecutive fills finding no task are recorded as one event.
+    trace->record_fill(0U, 1U, 0U);
+    trace->record_fill(1U, 2U, 0U);
+    trace->record_fill(2U, 3U, 0U);
+    trace->record_fill(3U, 4U, 8U);
+    trace->record_fill(4U, 5U, 0U);
+
+    auto events = std::vector<mx::tasking::profiling::TraceEvent>{};
+    trace->for_each([&events](const auto &event) { events.push_back(event); });
+    ASSERT_EQ(events.size(), 3U);
+    EXPECT_EQ(events[0U].start_timestamp, 0U);
+    EXPECT_EQ(events[0U].end_timestamp, 3U);
+    EXPECT_EQ(events[1U].buffer_size, 8U);
+    EXPECT_EQ(events[2U].task_type, nullptr);
+    EXPECT_EQ(events[2U].end_timestamp, 5U);
+}